@@ -7,14 +7,6 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
-	/*
-	 * Class:     dev_kastle_webrtc_logging_Logging
-	 * Method:    addLogSink
-	 * Signature: (Ldev/kastle/webrtc/logging/Logging/Severity;Ldev/kastle/webrtc/logging/LogSink;)V
-	 */
-	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_addLogSink
-	(JNIEnv *, jclass, jobject, jobject);
-
 	/*
 	 * Class:     dev_kastle_webrtc_logging_Logging
 	 * Method:    log
@@ -47,6 +39,22 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_logTimestamps
 	(JNIEnv *, jclass, jboolean);
 
+	/*
+	 * Class:     dev_kastle_webrtc_logging_Logging
+	 * Method:    addLogSinkConfig
+	 * Signature: (Ldev/kastle/webrtc/logging/Logging/Severity;Ldev/kastle/webrtc/logging/LogSink;Ldev/kastle/webrtc/logging/LogSinkConfig;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_addLogSinkConfig
+	(JNIEnv *, jclass, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_logging_Logging
+	 * Method:    removeLogSink
+	 * Signature: (Ldev/kastle/webrtc/logging/LogSink;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_removeLogSink
+	(JNIEnv *, jclass, jobject);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,19 +18,99 @@ extern "C" {
 
 	/*
 	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
-	 * Method:    dispose
+	 * Method:    createPeerConnectionCompiled
+	 * Signature: (Ldev/kastle/webrtc/CompiledRTCConfiguration;Ldev/kastle/webrtc/PeerConnectionObserver;)Ldev/kastle/webrtc/RTCPeerConnection;
+	 */
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_createPeerConnectionCompiled
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    compileConfiguration
+	 * Signature: (Ldev/kastle/webrtc/RTCConfiguration;)Ldev/kastle/webrtc/CompiledRTCConfiguration;
+	 */
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_compileConfiguration
+	(JNIEnv *, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    compileDataChannelInit
+	 * Signature: (Ldev/kastle/webrtc/RTCDataChannelInit;)Ldev/kastle/webrtc/CompiledRTCDataChannelInit;
+	 */
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_compileDataChannelInit
+	(JNIEnv *, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    disposeFactory
 	 * Signature: ()V
 	 */
-	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_dispose
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_disposeFactory
 	(JNIEnv *, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    flushSignalingThreads
+	 * Signature: ()V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_flushSignalingThreads
+	(JNIEnv *, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    getShardLoad
+	 * Signature: ()[I
+	 */
+	JNIEXPORT jintArray JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_getShardLoad
+	(JNIEnv *, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    getOffloadedDatagrams
+	 * Signature: ()J
+	 */
+	JNIEXPORT jlong JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_getOffloadedDatagrams
+	(JNIEnv *, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    isUdpOffloadSupported
+	 * Signature: ()Z
+	 */
+	JNIEXPORT jboolean JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_isUdpOffloadSupported
+	(JNIEnv *, jclass);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    processMessages
+	 * Signature: (I)Z
+	 */
+	JNIEXPORT jboolean JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_processMessages
+	(JNIEnv *, jobject, jint);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    generateCertificate
+	 * Signature: (Ldev/kastle/webrtc/RTCKeyType;J)Ldev/kastle/webrtc/RTCCertificate;
+	 */
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_generateCertificate
+	(JNIEnv *, jobject, jobject, jlong);
+
+	/*
+	 * Class:     dev_kastle_webrtc_PeerConnectionFactory
+	 * Method:    generateCertificateFuture
+	 * Signature: (Ldev/kastle/webrtc/RTCKeyType;JLjava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_generateCertificateFuture
+	(JNIEnv *, jobject, jobject, jlong, jobject);
+
     /*
     * Class:     dev_kastle_webrtc_PeerConnectionFactory
     * Method:    initialize
-    * Signature: ()V
+    * Signature: (Ldev/kastle/webrtc/PeerConnectionFactoryConfig;)V
     */
     JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_initialize
-    (JNIEnv *, jobject);
+    (JNIEnv *, jobject, jobject);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,29 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class dev_kastle_webrtc_RTCCertificate */
+
+#ifndef _Included_dev_kastle_webrtc_RTCCertificate
+#define _Included_dev_kastle_webrtc_RTCCertificate
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/*
+	 * Class:     dev_kastle_webrtc_RTCCertificate
+	 * Method:    getExpires
+	 * Signature: ()J
+	 */
+	JNIEXPORT jlong JNICALL Java_dev_kastle_webrtc_RTCCertificate_getExpires
+	(JNIEnv *, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCCertificate
+	 * Method:    toPEM
+	 * Signature: ()Ldev/kastle/webrtc/RTCCertificatePEM;
+	 */
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCCertificate_toPEM
+	(JNIEnv *, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -103,6 +103,14 @@ extern "C" {
 	JNIEXPORT jlong JNICALL Java_dev_kastle_webrtc_RTCDataChannel_getBufferedAmount
 	(JNIEnv *, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCDataChannel
+	 * Method:    getCounters
+	 * Signature: ([J)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_getCounters
+	(JNIEnv *, jobject, jlongArray);
+
 	/*
 	 * Class:     dev_kastle_webrtc_RTCDataChannel
 	 * Method:    close
@@ -111,6 +119,14 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_close
 	(JNIEnv *, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCDataChannel
+	 * Method:    closeWhenDrainedFuture
+	 * Signature: (JLjava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_closeWhenDrainedFuture
+	(JNIEnv *, jobject, jlong, jobject);
+
 	/*
 	 * Class:     dev_kastle_webrtc_RTCDataChannel
 	 * Method:    dispose
@@ -135,6 +151,14 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_sendByteArrayBuffer
 	(JNIEnv *, jobject, jbyteArray, jboolean);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCDataChannel
+	 * Method:    initialize
+	 * Signature: ()V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_initialize
+	(JNIEnv *, jobject);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,6 +16,22 @@ extern "C" {
 	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataChannel
 	(JNIEnv *, jobject, jstring, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    createDataChannelsInit
+	 * Signature: ([Ljava/lang/String;[Ldev/kastle/webrtc/RTCDataChannelInit;)[Ldev/kastle/webrtc/RTCDataChannel;
+	 */
+	JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataChannelsInit
+	(JNIEnv *, jobject, jobjectArray, jobjectArray);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    createDataChannelsCompiled
+	 * Signature: ([Ljava/lang/String;[Ldev/kastle/webrtc/CompiledRTCDataChannelInit;)[Ldev/kastle/webrtc/RTCDataChannel;
+	 */
+	JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataChannelsCompiled
+	(JNIEnv *, jobject, jobjectArray, jobjectArray);
+
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
 	 * Method:    createOffer
@@ -32,6 +48,22 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAnswer
 	(JNIEnv *, jobject, jobject, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    createAndSetLocalOffer
+	 * Signature: (Ldev/kastle/webrtc/RTCOfferOptions;Ldev/kastle/webrtc/NegotiationCallback;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAndSetLocalOffer
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    answerRemoteOffer
+	 * Signature: (Ljava/lang/String;Ldev/kastle/webrtc/RTCAnswerOptions;Ldev/kastle/webrtc/NegotiationCallback;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_answerRemoteOffer
+	(JNIEnv *, jobject, jstring, jobject, jobject);
+
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
 	 * Method:    getCurrentLocalDescription
@@ -104,6 +136,22 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_addIceCandidate
 	(JNIEnv *, jobject, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    addIceCandidatesFuture
+	 * Signature: ([Ldev/kastle/webrtc/RTCIceCandidate;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_addIceCandidatesFuture
+	(JNIEnv *, jobject, jobjectArray, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    addIceCandidatesRaw
+	 * Signature: ([Ljava/lang/String;[I[Ljava/lang/String;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_addIceCandidatesRaw
+	(JNIEnv *, jobject, jobjectArray, jintArray, jobjectArray, jobject);
+
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
 	 * Method:    removeIceCandidates
@@ -146,18 +194,18 @@ extern "C" {
 
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
-	 * Method:    getConfiguration
+	 * Method:    queryConfiguration
 	 * Signature: ()Ldev/kastle/webrtc/RTCConfiguration;
 	 */
-	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getConfiguration
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_queryConfiguration
 	(JNIEnv *, jobject);
 
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
-	 * Method:    setConfiguration
+	 * Method:    applyConfiguration
 	 * Signature: (Ldev/kastle/webrtc/RTCConfiguration;)V
 	 */
-	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setConfiguration
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_applyConfiguration
 	(JNIEnv *, jobject, jobject);
 
 	/*
@@ -168,6 +216,54 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getStats__Ldev_kastle_webrtc_RTCStatsCollectorCallback_2
 	(JNIEnv *, jobject, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    getStatsSerialized
+	 * Signature: (Ldev/kastle/webrtc/RTCStatsFormat;Ldev/kastle/webrtc/RTCStatsSerializedCallback;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getStatsSerialized
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    createOfferFuture
+	 * Signature: (Ldev/kastle/webrtc/RTCOfferOptions;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createOfferFuture
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    createAnswerFuture
+	 * Signature: (Ldev/kastle/webrtc/RTCAnswerOptions;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAnswerFuture
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    setLocalDescriptionFuture
+	 * Signature: (Ldev/kastle/webrtc/RTCSessionDescription;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setLocalDescriptionFuture
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    setRemoteDescriptionFuture
+	 * Signature: (Ldev/kastle/webrtc/RTCSessionDescription;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setRemoteDescriptionFuture
+	(JNIEnv *, jobject, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    getStatsFuture
+	 * Signature: (Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getStatsFuture
+	(JNIEnv *, jobject, jobject);
+
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
 	 * Method:    restartIce
@@ -178,12 +274,28 @@ extern "C" {
 
 	/*
 	 * Class:     dev_kastle_webrtc_RTCPeerConnection
-	 * Method:    close
+	 * Method:    closeConnection
 	 * Signature: ()V
 	 */
-	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_close
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_closeConnection
 	(JNIEnv *, jobject);
 
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    closeFuture
+	 * Signature: (Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_closeFuture
+	(JNIEnv *, jobject, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_RTCPeerConnection
+	 * Method:    closeAll
+	 * Signature: ([Ldev/kastle/webrtc/RTCPeerConnection;Ljava/util/concurrent/CompletableFuture;)V
+	 */
+	JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_closeAll
+	(JNIEnv *, jclass, jobjectArray, jobject);
+
 #ifdef __cplusplus
 }
 #endif
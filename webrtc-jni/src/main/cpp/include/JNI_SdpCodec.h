@@ -0,0 +1,45 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class dev_kastle_webrtc_SdpCodec */
+
+#ifndef _Included_dev_kastle_webrtc_SdpCodec
+#define _Included_dev_kastle_webrtc_SdpCodec
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/*
+	 * Class:     dev_kastle_webrtc_SdpCodec
+	 * Method:    encodeDescription
+	 * Signature: (Ldev/kastle/webrtc/RTCSessionDescription;)[B
+	 */
+	JNIEXPORT jbyteArray JNICALL Java_dev_kastle_webrtc_SdpCodec_encodeDescription
+	(JNIEnv *, jclass, jobject);
+
+	/*
+	 * Class:     dev_kastle_webrtc_SdpCodec
+	 * Method:    decodeDescription
+	 * Signature: ([B)Ldev/kastle/webrtc/RTCSessionDescription;
+	 */
+	JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_SdpCodec_decodeDescription
+	(JNIEnv *, jclass, jbyteArray);
+
+	/*
+	 * Class:     dev_kastle_webrtc_SdpCodec
+	 * Method:    encodeCandidates
+	 * Signature: ([Ldev/kastle/webrtc/RTCIceCandidate;)[B
+	 */
+	JNIEXPORT jbyteArray JNICALL Java_dev_kastle_webrtc_SdpCodec_encodeCandidates
+	(JNIEnv *, jclass, jobjectArray);
+
+	/*
+	 * Class:     dev_kastle_webrtc_SdpCodec
+	 * Method:    decodeCandidates
+	 * Signature: ([B)[Ldev/kastle/webrtc/RTCIceCandidate;
+	 */
+	JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_SdpCodec_decodeCandidates
+	(JNIEnv *, jclass, jbyteArray);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
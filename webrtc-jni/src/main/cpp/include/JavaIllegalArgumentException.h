@@ -0,0 +1,56 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_JAVA_ILLEGAL_ARGUMENT_EXCEPTION_H_
+#define JNI_WEBRTC_JAVA_ILLEGAL_ARGUMENT_EXCEPTION_H_
+
+#include "JavaThrowable.h"
+
+#include <jni.h>
+
+namespace jni
+{
+	/*
+	 * Reports invalid arguments passed by the caller, as opposed to failures
+	 * of the native library.
+	 */
+	class JavaIllegalArgumentException : public JavaThrowable
+	{
+		private:
+			class JavaIllegalArgumentExceptionClass : public JavaThrowableClass
+			{
+				public:
+					JavaIllegalArgumentExceptionClass(JNIEnv * env) :
+						JavaThrowableClass(env, "java/lang/IllegalArgumentException")
+					{
+					}
+			};
+
+		public:
+			template <typename... Args>
+			JavaIllegalArgumentException(JNIEnv * env, const char * message, Args &&... args) :
+				JavaThrowable(env, message, std::forward<Args>(args)...)
+			{
+			}
+
+			operator jthrowable() const override
+			{
+				return createThrowable<JavaIllegalArgumentExceptionClass>();
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,264 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_SHARDED_PEER_CONNECTION_FACTORY_H_
+#define JNI_WEBRTC_SHARDED_PEER_CONNECTION_FACTORY_H_
+
+#include "absl/functional/any_invocable.h"
+#include "api/environment/environment.h"
+#include "api/packet_socket_factory.h"
+#include "api/peer_connection_interface.h"
+#include "api/ref_count.h"
+#include "api/rtc_error.h"
+#include "api/scoped_refptr.h"
+#include "p2p/base/port_allocator.h"
+#include "rtc_base/network.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/thread.h"
+#include "rtc/FilteringNetworkManager.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace jni
+{
+	class BatchingSocketServer;
+	class SharedUdpPort;
+
+	struct PendingCertificates;
+
+	/*
+	 * Receives a generated certificate, or the error if generation failed or
+	 * the factory was disposed before it finished.
+	 */
+	using CertificateCallback = absl::AnyInvocable<void(webrtc::RTCErrorOr<webrtc::scoped_refptr<webrtc::RTCCertificate>>) &&>;
+
+	enum class PeerConnectionPlacement {
+		kRoundRobin,
+		kLeastLoaded
+	};
+
+	enum class SocketServerType {
+		kDefault,
+		kBatching
+	};
+
+	struct PeerConnectionFactoryOptions
+	{
+		int shards = 1;
+		PeerConnectionPlacement placement = PeerConnectionPlacement::kRoundRobin;
+		bool singleThread = false;
+		bool applicationSignalingThread = false;
+		SocketServerType socketServer = SocketServerType::kDefault;
+		bool udpOffload = false;
+	};
+
+	/*
+	 * Number of open peer connections of a shard. Each RTCPeerConnection keeps
+	 * a reference, so that closing a connection after its factory has been
+	 * disposed remains safe.
+	 */
+	class PeerConnectionShardLoad : public webrtc::RefCountInterface
+	{
+		public:
+			void increment()
+			{
+				count.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			void decrement()
+			{
+				count.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			// Increments the count only if it still has the expected value.
+			bool tryIncrement(int expected)
+			{
+				return count.compare_exchange_strong(expected, expected + 1, std::memory_order_relaxed);
+			}
+
+			int get() const
+			{
+				return count.load(std::memory_order_relaxed);
+			}
+
+		protected:
+			~PeerConnectionShardLoad() override = default;
+
+		private:
+			std::atomic<int> count { 0 };
+	};
+
+	/*
+	 * A network, signaling and worker thread triplet together with the
+	 * PeerConnectionFactory running on these threads. In single-thread mode
+	 * one thread with a socket server takes all three roles. With an
+	 * application signaling thread the creating thread is wrapped and becomes
+	 * the signaling thread, driven by processMessages().
+	 */
+	class PeerConnectionFactoryShard
+	{
+		public:
+			PeerConnectionFactoryShard(const PeerConnectionFactoryOptions & options, std::size_t index);
+			~PeerConnectionFactoryShard();
+
+			webrtc::PeerConnectionFactoryInterface * getFactory() const;
+			PeerConnectionShardLoad * getLoad() const;
+			webrtc::Thread * getSignalingThread() const;
+
+			/*
+			 * Returns the number of datagrams the network thread has sent
+			 * with UDP segmentation offload.
+			 */
+			uint64_t getOffloadedDatagrams() const;
+
+			/*
+			 * Generates a certificate on the worker thread and runs the
+			 * callback on the signaling thread. Generations still pending when
+			 * the shard is disposed fail on the disposing thread.
+			 */
+			void generateCertificate(const webrtc::KeyParams & params, const std::optional<uint64_t> & expiresMs,
+				CertificateCallback callback);
+
+			/*
+			 * Processes pending messages of the application signaling thread.
+			 * Must be called on the thread that created this shard.
+			 */
+			bool processMessages(int timeoutMs);
+
+			/*
+			 * Runs all tasks already posted to the signaling thread, e.g.
+			 * pending close batches. An application signaling thread can only
+			 * be flushed on that thread.
+			 */
+			void flushSignalingThread();
+
+			/*
+			 * Creates the port allocator of a single peer connection. All
+			 * allocators of a shard share one network manager, which keeps the
+			 * enumerated networks cached and up to date for the lifetime of the
+			 * shard. With a shared UDP port, all UDP ICE ports are bound to that
+			 * port together with every other connection using the same port.
+			 * The network filter limits the shared networks used by the
+			 * connection.
+			 */
+			std::unique_ptr<webrtc::PortAllocator> createPortAllocator(uint16_t sharedUdpPort, const NetworkFilter & networkFilter);
+
+			/*
+			 * Releases the factory and stops the threads. Returns false if the
+			 * factory is still referenced elsewhere.
+			 */
+			bool dispose();
+
+		private:
+			const webrtc::Environment environment;
+
+			std::unique_ptr<webrtc::Thread> networkThread;
+			std::unique_ptr<webrtc::Thread> signalingThread;
+			std::unique_ptr<webrtc::Thread> workerThread;
+
+			// Wrapped by the ThreadManager, not owned.
+			webrtc::Thread * applicationThread = nullptr;
+			bool unwrapApplicationThread = false;
+
+			// One of the threads above, depending on the threading mode.
+			webrtc::Thread * signalingRole = nullptr;
+
+			// The socket server of the network thread, if it is a batching one.
+			BatchingSocketServer * batchingSocketServer = nullptr;
+
+			// Guarded by the mutex of the pending certificates.
+			std::unique_ptr<webrtc::RTCCertificateGenerator> certificateGenerator;
+
+			// Shared with the generator callbacks, which may outlive the shard
+			// on an application signaling thread.
+			const std::shared_ptr<PendingCertificates> pendingCertificates;
+
+			webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory;
+			webrtc::scoped_refptr<PeerConnectionShardLoad> load;
+
+			// Created on the network thread and shared by all port allocators.
+			std::unique_ptr<webrtc::BasicNetworkManager> networkManager;
+			std::unique_ptr<webrtc::PacketSocketFactory> socketFactory;
+
+			// Shared UDP ports by port number.
+			std::map<uint16_t, std::shared_ptr<SharedUdpPort>> sharedUdpPorts;
+			std::mutex socketFactoryMutex;
+	};
+
+	/*
+	 * Distributes peer connections over one or more independent
+	 * PeerConnectionFactory shards.
+	 */
+	class ShardedPeerConnectionFactory
+	{
+		public:
+			explicit ShardedPeerConnectionFactory(const PeerConnectionFactoryOptions & options);
+			~ShardedPeerConnectionFactory() = default;
+
+			/*
+			 * Returns the shard the next peer connection should be placed on
+			 * and reserves a slot in its load. The caller must decrement the
+			 * load if the peer connection cannot be created.
+			 */
+			PeerConnectionFactoryShard * selectShard();
+
+			std::vector<int> getLoad() const;
+
+			std::size_t getShardCount() const;
+
+			uint64_t getOffloadedDatagrams() const;
+
+			/*
+			 * Returns whether UDP segmentation offload works on this host, i.e.
+			 * whether the udpOffload option has any effect.
+			 */
+			static bool isUdpOffloadSupported();
+
+			/*
+			 * Generates a certificate on the worker thread of a shard and runs
+			 * the callback on the signaling thread of that shard. Shards are
+			 * used in turn, regardless of their load.
+			 */
+			void generateCertificate(const webrtc::KeyParams & params, const std::optional<uint64_t> & expiresMs,
+				CertificateCallback callback);
+
+			bool processMessages(int timeoutMs);
+
+			void flushSignalingThreads();
+
+			/*
+			 * Disposes all shards. Returns false if any factory is still
+			 * referenced elsewhere.
+			 */
+			bool dispose();
+
+		private:
+			const PeerConnectionFactoryOptions options;
+
+			std::vector<std::unique_ptr<PeerConnectionFactoryShard>> shards;
+			std::atomic<std::size_t> nextShard { 0 };
+			std::atomic<std::size_t> nextCertificateShard { 0 };
+	};
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_COMPILED_RTC_CONFIGURATION_H_
+#define JNI_WEBRTC_API_COMPILED_RTC_CONFIGURATION_H_
+
+#include "api/RTCConfiguration.h"
+
+#include "api/ref_count.h"
+
+#include <utility>
+
+namespace jni
+{
+	/*
+	 * An immutable, converted RTCConfiguration shared by all peer connections
+	 * created from it. Held by a Java CompiledRTCConfiguration.
+	 */
+	class CompiledRTCConfiguration : public webrtc::RefCountInterface
+	{
+		public:
+			explicit CompiledRTCConfiguration(PeerConnectionConfiguration config) :
+				config(std::move(config))
+			{
+			}
+
+			const PeerConnectionConfiguration & get() const
+			{
+				return config;
+			}
+
+		protected:
+			~CompiledRTCConfiguration() override = default;
+
+		private:
+			const PeerConnectionConfiguration config;
+	};
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_COMPILED_RTC_DATA_CHANNEL_INIT_H_
+#define JNI_WEBRTC_API_COMPILED_RTC_DATA_CHANNEL_INIT_H_
+
+#include "api/data_channel_interface.h"
+#include "api/ref_count.h"
+
+#include <utility>
+
+namespace jni
+{
+	/*
+	 * An immutable, converted RTCDataChannelInit shared by all data channels
+	 * created from it. Held by a Java CompiledRTCDataChannelInit.
+	 */
+	class CompiledRTCDataChannelInit : public webrtc::RefCountInterface
+	{
+		public:
+			explicit CompiledRTCDataChannelInit(webrtc::DataChannelInit init) :
+				init(std::move(init))
+			{
+			}
+
+			const webrtc::DataChannelInit & get() const
+			{
+				return init;
+			}
+
+		protected:
+			~CompiledRTCDataChannelInit() override = default;
+
+		private:
+			const webrtc::DataChannelInit init;
+	};
+}
+
+#endif
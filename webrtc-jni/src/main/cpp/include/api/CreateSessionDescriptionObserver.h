@@ -29,7 +29,12 @@ namespace jni
 	class CreateSessionDescriptionObserver : public webrtc::CreateSessionDescriptionObserver
 	{
 		public:
-			explicit CreateSessionDescriptionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer);
+			/*
+			 * With iceLite set, created descriptions announce the ICE-lite mode
+			 * in all transports. With sdpTemplate set, they are serialized by
+			 * the SdpTemplate fast path.
+			 */
+			explicit CreateSessionDescriptionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer, bool iceLite = false, bool sdpTemplate = false);
 			~CreateSessionDescriptionObserver() = default;
 
 			// SetSessionDescriptionObserver implementation.
@@ -49,6 +54,10 @@ namespace jni
 		private:
 			JavaGlobalRef<jobject> observer;
 
+			const bool iceLite;
+
+			const bool sdpTemplate;
+
 			const std::shared_ptr<JavaCreateSessionDescObserverClass> javaClass;
 	};
 }
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_FUTURE_OBSERVERS_H_
+#define JNI_WEBRTC_API_FUTURE_OBSERVERS_H_
+
+#include "JavaClass.h"
+#include "JavaRef.h"
+
+#include "api/jsep.h"
+#include "api/rtc_error.h"
+#include "api/set_local_description_observer_interface.h"
+#include "api/set_remote_description_observer_interface.h"
+#include "api/stats/rtc_stats_collector_callback.h"
+
+#include <jni.h>
+#include <memory>
+
+namespace jni
+{
+	/*
+	 * Completes a java.util.concurrent.CompletableFuture directly from native
+	 * callbacks, without a Java observer in between.
+	 */
+	class JavaFuture
+	{
+		public:
+			JavaFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future);
+			~JavaFuture() = default;
+
+			void complete(JNIEnv * env, jobject value);
+			void fail(JNIEnv * env, const webrtc::RTCError & error);
+
+		private:
+			class JavaCompletableFutureClass : public JavaClass
+			{
+				public:
+					explicit JavaCompletableFutureClass(JNIEnv * env);
+
+					jmethodID complete;
+					jmethodID completeExceptionally;
+			};
+
+		private:
+			JavaGlobalRef<jobject> future;
+
+			const std::shared_ptr<JavaCompletableFutureClass> javaClass;
+	};
+
+
+	class CreateSessionDescriptionFuture : public webrtc::CreateSessionDescriptionObserver
+	{
+		public:
+			CreateSessionDescriptionFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future, bool iceLite, bool sdpTemplate);
+			~CreateSessionDescriptionFuture() = default;
+
+			// CreateSessionDescriptionObserver implementation.
+			void OnSuccess(webrtc::SessionDescriptionInterface * desc) override;
+			void OnFailure(webrtc::RTCError error) override;
+
+		private:
+			JavaFuture future;
+
+			const bool iceLite;
+
+			const bool sdpTemplate;
+	};
+
+
+	class SetLocalDescriptionFuture : public webrtc::SetLocalDescriptionObserverInterface
+	{
+		public:
+			SetLocalDescriptionFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future);
+			~SetLocalDescriptionFuture() = default;
+
+			// SetLocalDescriptionObserverInterface implementation.
+			void OnSetLocalDescriptionComplete(webrtc::RTCError error) override;
+
+		private:
+			JavaFuture future;
+	};
+
+
+	class SetRemoteDescriptionFuture : public webrtc::SetRemoteDescriptionObserverInterface
+	{
+		public:
+			SetRemoteDescriptionFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future);
+			~SetRemoteDescriptionFuture() = default;
+
+			// SetRemoteDescriptionObserverInterface implementation.
+			void OnSetRemoteDescriptionComplete(webrtc::RTCError error) override;
+
+		private:
+			JavaFuture future;
+	};
+
+
+	class RTCStatsFuture : public webrtc::RTCStatsCollectorCallback
+	{
+		public:
+			RTCStatsFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future);
+			~RTCStatsFuture() = default;
+
+			// RTCStatsCollectorCallback implementation.
+			void OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport> & report) override;
+
+		private:
+			JavaFuture future;
+	};
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_ICE_CANDIDATE_BATCH_H_
+#define JNI_WEBRTC_API_ICE_CANDIDATE_BATCH_H_
+
+#include "api/FutureObservers.h"
+#include "JavaClass.h"
+
+#include "api/jsep.h"
+#include "api/peer_connection_interface.h"
+#include "api/rtc_error.h"
+
+#include <jni.h>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace jni
+{
+	/*
+	 * Remote ICE candidates parsed in one pass and added to a peer connection
+	 * in one signaling thread task. The future is completed with one error
+	 * message per candidate, null for candidates that were added.
+	 */
+	class IceCandidateBatch : public std::enable_shared_from_this<IceCandidateBatch>
+	{
+		public:
+			IceCandidateBatch(JNIEnv * env, const JavaGlobalRef<jobject> & future, std::size_t size);
+			~IceCandidateBatch() = default;
+
+			void parse(std::size_t index, const std::string & sdpMid, int sdpMLineIndex, const std::string & sdp);
+			void reject(std::size_t index, const std::string & error);
+
+			/*
+			 * Adds all parsed candidates. Must be called on the signaling
+			 * thread of the peer connection.
+			 */
+			void apply(webrtc::PeerConnectionInterface * pc);
+
+		private:
+			class JavaStringClass : public JavaClass
+			{
+				public:
+					explicit JavaStringClass(JNIEnv * env);
+
+					jclass cls;
+			};
+
+		private:
+			void onAdded(std::size_t index, const webrtc::RTCError & error);
+			void complete();
+
+		private:
+			JavaFuture future;
+
+			std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> candidates;
+			std::vector<std::optional<std::string>> errors;
+
+			// Accessed on the signaling thread only.
+			std::size_t pending;
+
+			const std::shared_ptr<JavaStringClass> stringClass;
+	};
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_NEGOTIATION_PIPELINE_H_
+#define JNI_WEBRTC_API_NEGOTIATION_PIPELINE_H_
+
+#include "JavaClass.h"
+#include "JavaRef.h"
+
+#include "api/jsep.h"
+#include "api/peer_connection_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/set_local_description_observer_interface.h"
+#include "api/set_remote_description_observer_interface.h"
+
+#include <jni.h>
+#include <memory>
+#include <string>
+
+namespace jni
+{
+	/*
+	 * Chains the steps of an offer/answer exchange on the signaling thread:
+	 * create and set a local offer, or set a remote offer, create and set the
+	 * local answer. Only the final local SDP is passed to the Java callback.
+	 */
+	class NegotiationPipeline : public webrtc::CreateSessionDescriptionObserver
+	{
+		public:
+			NegotiationPipeline(JNIEnv * env, webrtc::scoped_refptr<webrtc::PeerConnectionInterface> pc,
+				const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions & options,
+				const JavaGlobalRef<jobject> & callback, bool iceLite, bool sdpTemplate);
+			~NegotiationPipeline() = default;
+
+			void createOffer();
+			void answerOffer(std::unique_ptr<webrtc::SessionDescriptionInterface> offer);
+
+			// CreateSessionDescriptionObserver implementation.
+			void OnSuccess(webrtc::SessionDescriptionInterface * desc) override;
+			void OnFailure(webrtc::RTCError error) override;
+
+		private:
+			class RemoteDescriptionObserver : public webrtc::SetRemoteDescriptionObserverInterface
+			{
+				public:
+					explicit RemoteDescriptionObserver(webrtc::scoped_refptr<NegotiationPipeline> pipeline);
+
+					void OnSetRemoteDescriptionComplete(webrtc::RTCError error) override;
+
+				private:
+					const webrtc::scoped_refptr<NegotiationPipeline> pipeline;
+			};
+
+			class LocalDescriptionObserver : public webrtc::SetLocalDescriptionObserverInterface
+			{
+				public:
+					explicit LocalDescriptionObserver(webrtc::scoped_refptr<NegotiationPipeline> pipeline);
+
+					void OnSetLocalDescriptionComplete(webrtc::RTCError error) override;
+
+				private:
+					const webrtc::scoped_refptr<NegotiationPipeline> pipeline;
+			};
+
+			class JavaNegotiationCallbackClass : public JavaClass
+			{
+				public:
+					explicit JavaNegotiationCallbackClass(JNIEnv * env);
+
+					jmethodID onSuccess;
+					jmethodID onFailure;
+			};
+
+		private:
+			void onRemoteDescriptionSet(webrtc::RTCError error);
+			void onLocalDescriptionSet(webrtc::RTCError error);
+			void notifyFailure(const webrtc::RTCError & error);
+
+		private:
+			const webrtc::scoped_refptr<webrtc::PeerConnectionInterface> pc;
+			const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
+
+			JavaGlobalRef<jobject> callback;
+
+			const bool iceLite;
+
+			const bool sdpTemplate;
+
+			// The local description, serialized before it is handed to the PeerConnection.
+			std::string sdp;
+
+			const std::shared_ptr<JavaNegotiationCallbackClass> javaClass;
+	};
+}
+
+#endif
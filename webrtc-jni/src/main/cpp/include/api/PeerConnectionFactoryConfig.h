@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_PEER_CONNECTION_FACTORY_CONFIG_H_
+#define JNI_WEBRTC_API_PEER_CONNECTION_FACTORY_CONFIG_H_
+
+#include "ShardedPeerConnectionFactory.h"
+#include "JavaClass.h"
+#include "JavaRef.h"
+
+#include <jni.h>
+
+namespace jni
+{
+	namespace PeerConnectionFactoryConfig
+	{
+		class JavaPeerConnectionFactoryConfigClass : public JavaClass
+		{
+			public:
+				explicit JavaPeerConnectionFactoryConfigClass(JNIEnv * env);
+
+				jclass cls;
+				jfieldID shards;
+				jfieldID placement;
+				jfieldID singleThread;
+				jfieldID applicationSignalingThread;
+				jfieldID socketServer;
+				jfieldID udpOffload;
+		};
+
+		PeerConnectionFactoryOptions toNative(JNIEnv * env, const JavaRef<jobject> & javaType);
+	}
+}
+
+#endif
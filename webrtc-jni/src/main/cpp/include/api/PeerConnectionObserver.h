@@ -20,19 +20,34 @@
 #include "JavaClass.h"
 #include "JavaRef.h"
 
+#include "api/jsep.h"
 #include "api/peer_connection_interface.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 
 #include <jni.h>
 #include <memory>
+#include <vector>
 
 namespace jni
 {
 	class PeerConnectionObserver : public webrtc::PeerConnectionObserver
 	{
 		public:
-			PeerConnectionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer);
+			/*
+			 * A non-zero candidate batch window coalesces gathered candidates
+			 * into onIceCandidates() upcalls: a positive window in
+			 * milliseconds, a negative one until gathering completes.
+			 */
+			PeerConnectionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer, int candidateBatchWindow = 0);
 			virtual ~PeerConnectionObserver() = default;
 
+			/*
+			 * Delivers the candidates still held by the batch window. Called on
+			 * the signaling thread once the peer connection has been closed and
+			 * before the observer is deleted there.
+			 */
+			void close();
+
 			// PeerConnectionObserver implementation.
 			void OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState state) override;
 			void OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState state) override;
@@ -58,14 +73,25 @@ namespace jni
 					jmethodID onIceConnectionChange;
 					jmethodID onIceGatheringChange;
 					jmethodID onIceCandidate;
+					jmethodID onIceCandidates;
 					jmethodID onIceCandidateError;
 					jmethodID onIceCandidatesRemoved;
 					jmethodID onIceConnectionReceivingChange;
 			};
 
+		private:
+			void flushIceCandidates();
+
 		private:
 			JavaGlobalRef<jobject> observer;
 
+			const int candidateBatchWindow;
+
+			// Accessed on the signaling thread only.
+			std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> pendingCandidates;
+
+			webrtc::ScopedTaskSafetyDetached safety;
+
 			const std::shared_ptr<JavaPeerConnectionObserverClass> javaClass;
 	};
 }
@@ -21,6 +21,7 @@
 #include "JavaRef.h"
 
 #include "api/peer_connection_interface.h"
+#include "rtc/FilteringNetworkManager.h"
 
 #include <jni.h>
 
@@ -38,9 +39,32 @@ namespace jni
 				jfieldID minPort;
 				jfieldID maxPort;
 				jfieldID flags;
+				jfieldID sharedUdpPort;
+				jfieldID interfaceAllowList;
+				jfieldID interfaceDenyList;
+				jfieldID networkIgnoreMask;
+				jfieldID disableIpv6;
+				jfieldID maxNetworksPerInterface;
 		};
 
-		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::PortAllocatorConfig & cfg);
+		/*
+		 * Converts the native config together with the shared UDP port and the
+		 * network filter, which are applied by this library itself.
+		 */
+		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::PortAllocatorConfig & cfg,
+			int sharedUdpPort, const NetworkFilter & filter);
+
+		/*
+		 * Returns the shared UDP port of the given Java PortAllocatorConfig or
+		 * 0 if none is set. Sharing a port is not part of the native config.
+		 */
+		int getSharedUdpPort(JNIEnv * env, const JavaRef<jobject> & javaType);
+
+		/*
+		 * Returns the network filter of the given Java PortAllocatorConfig,
+		 * applied by the port allocator of the peer connection.
+		 */
+		NetworkFilter toNetworkFilter(JNIEnv * env, const JavaRef<jobject> & javaType);
 	}
 }
 
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_RTC_CERTIFICATE_REF_H_
+#define JNI_WEBRTC_API_RTC_CERTIFICATE_REF_H_
+
+#include "api/ref_count.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/rtc_certificate.h"
+
+#include <utility>
+
+namespace jni
+{
+	/*
+	 * A generated certificate held by a Java RTCCertificate. Wraps the
+	 * non-virtual ref count of webrtc::RTCCertificate, so that the Java object
+	 * is retained and released like the compiled configurations.
+	 */
+	class RTCCertificateRef : public webrtc::RefCountInterface
+	{
+		public:
+			explicit RTCCertificateRef(webrtc::scoped_refptr<webrtc::RTCCertificate> certificate) :
+				certificate(std::move(certificate))
+			{
+			}
+
+			const webrtc::scoped_refptr<webrtc::RTCCertificate> & get() const
+			{
+				return certificate;
+			}
+
+		protected:
+			~RTCCertificateRef() override = default;
+
+		private:
+			const webrtc::scoped_refptr<webrtc::RTCCertificate> certificate;
+	};
+}
+
+#endif
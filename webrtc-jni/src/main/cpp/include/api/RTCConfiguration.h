@@ -21,11 +21,36 @@
 #include "JavaRef.h"
 
 #include "api/peer_connection_interface.h"
+#include "rtc/FilteringNetworkManager.h"
 
 #include <jni.h>
 
 namespace jni
 {
+	/*
+	 * Settings this library applies itself when creating a peer connection.
+	 * They cannot be changed afterwards.
+	 */
+	struct PeerConnectionOptions
+	{
+		NetworkFilter networkFilter;
+		int sharedUdpPort = 0;
+		bool iceLite = false;
+		int iceCandidateBatchWindow = 0;
+		bool sdpTemplate = false;
+
+		bool operator==(const PeerConnectionOptions &) const = default;
+	};
+
+	/*
+	 * A native RTCConfiguration together with the creation options.
+	 */
+	struct PeerConnectionConfiguration
+	{
+		webrtc::PeerConnectionInterface::RTCConfiguration configuration;
+		PeerConnectionOptions options;
+	};
+
 	namespace RTCConfiguration
 	{
 		class JavaRTCConfigurationClass : public JavaClass
@@ -40,11 +65,18 @@ namespace jni
 				jfieldID bundlePolicy;
 				jfieldID rtcpMuxPolicy;
 				jfieldID certificates;
+				jfieldID nativeCertificates;
 				jfieldID portAllocatorConfig;
+				jfieldID iceCandidatePoolSize;
+				jfieldID iceLite;
+				jfieldID iceCandidateBatchWindow;
+				jfieldID sdpTemplate;
 		};
 
-		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::RTCConfiguration & config);
+		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::RTCConfiguration & config, const PeerConnectionOptions & options);
 		webrtc::PeerConnectionInterface::RTCConfiguration toNative(JNIEnv * env, const JavaRef<jobject> & javaType);
+
+		PeerConnectionConfiguration toPeerConnectionConfiguration(JNIEnv * env, const JavaRef<jobject> & javaType);
 	}
 }
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_RTC_DATA_CHANNEL_COUNTERS_H_
+#define JNI_WEBRTC_API_RTC_DATA_CHANNEL_COUNTERS_H_
+
+#include "api/ref_count.h"
+
+#include <jni.h>
+#include <atomic>
+#include <cstdint>
+
+namespace jni
+{
+	/*
+	 * Message and byte counters of a single data channel. Updated by the send
+	 * functions of the Java wrapper and by the RTCDataChannelObserver, read
+	 * lock-free by any Java thread.
+	 */
+	class RTCDataChannelCounters : public webrtc::RefCountInterface
+	{
+		public:
+			enum Index {
+				kMessagesSent,
+				kMessagesReceived,
+				kBytesSent,
+				kBytesReceived,
+				kCount
+			};
+
+			void messageSent(uint64_t size)
+			{
+				messagesSent.fetch_add(1, std::memory_order_relaxed);
+				bytesSent.fetch_add(size, std::memory_order_relaxed);
+			}
+
+			void messageReceived(uint64_t size)
+			{
+				messagesReceived.fetch_add(1, std::memory_order_relaxed);
+				bytesReceived.fetch_add(size, std::memory_order_relaxed);
+			}
+
+			void copyTo(jlong * values) const
+			{
+				values[kMessagesSent] = static_cast<jlong>(messagesSent.load(std::memory_order_relaxed));
+				values[kMessagesReceived] = static_cast<jlong>(messagesReceived.load(std::memory_order_relaxed));
+				values[kBytesSent] = static_cast<jlong>(bytesSent.load(std::memory_order_relaxed));
+				values[kBytesReceived] = static_cast<jlong>(bytesReceived.load(std::memory_order_relaxed));
+			}
+
+		protected:
+			~RTCDataChannelCounters() override = default;
+
+		private:
+			std::atomic<uint64_t> messagesSent { 0 };
+			std::atomic<uint64_t> messagesReceived { 0 };
+			std::atomic<uint64_t> bytesSent { 0 };
+			std::atomic<uint64_t> bytesReceived { 0 };
+	};
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_RTC_DATA_CHANNEL_DRAIN_H_
+#define JNI_WEBRTC_API_RTC_DATA_CHANNEL_DRAIN_H_
+
+#include "api/FutureObservers.h"
+#include "JavaRef.h"
+
+#include "api/data_channel_interface.h"
+#include "api/ref_count.h"
+
+#include <jni.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace jni
+{
+	/*
+	 * Closes a data channel once all queued data has been handed to the
+	 * transport, or once a deadline passes, and completes a
+	 * CompletableFuture<Boolean> telling which of both happened first. One
+	 * instance belongs to each Java RTCDataChannel wrapper and is shared by all
+	 * observers registered on it, so replacing the observer keeps the drain
+	 * informed. The channel is not owned, the wrapper cancels the drain before
+	 * releasing it. check() and expire() must be called on the signaling thread.
+	 */
+	class RTCDataChannelDrain : public webrtc::RefCountInterface
+	{
+		public:
+			RTCDataChannelDrain() = default;
+
+			// Starts watching the channel and returns the generation to pass to expire().
+			// Fails the future if a drain is already pending.
+			uint64_t start(JNIEnv * env, webrtc::DataChannelInterface * channel, const JavaGlobalRef<jobject> & future);
+			// Closes the channel if its buffer is empty or it is already closing.
+			void check();
+			// Closes the channel regardless of the buffered amount, unless the given drain has already finished.
+			void expire(uint64_t generation);
+			// Forgets the channel and fails a pending future. Called before the channel is released.
+			void cancel(JNIEnv * env);
+
+		protected:
+			~RTCDataChannelDrain() override = default;
+
+		private:
+			void finish(std::unique_lock<std::recursive_mutex> & lock, bool drained);
+
+		private:
+			// Recursive, closing the channel reports the state change synchronously.
+			std::recursive_mutex mutex;
+
+			webrtc::DataChannelInterface * channel = nullptr;
+
+			std::unique_ptr<JavaFuture> future;
+
+			uint64_t generation = 0;
+	};
+}
+
+#endif
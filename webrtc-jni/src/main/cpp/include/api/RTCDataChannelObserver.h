@@ -21,7 +21,10 @@
 #include "JavaRef.h"
 
 #include "api/data_channel_interface.h"
+#include "api/scoped_refptr.h"
 #include <api/DataBufferFactory.h>
+#include <api/RTCDataChannelCounters.h>
+#include <api/RTCDataChannelDrain.h>
 
 #include <jni.h>
 #include <memory>
@@ -31,7 +34,9 @@ namespace jni
 	class RTCDataChannelObserver : public webrtc::DataChannelObserver
 	{
 		public:
-			explicit RTCDataChannelObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer);
+			explicit RTCDataChannelObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer,
+				webrtc::scoped_refptr<RTCDataChannelCounters> counters = nullptr,
+				webrtc::scoped_refptr<RTCDataChannelDrain> drain = nullptr);
 			~RTCDataChannelObserver() = default;
 
 			// DataChannelObserver implementation.
@@ -55,6 +60,10 @@ namespace jni
 
 			std::unique_ptr<DataBufferFactory> bufferFactory;
 
+			webrtc::scoped_refptr<RTCDataChannelCounters> counters;
+
+			webrtc::scoped_refptr<RTCDataChannelDrain> drain;
+
 			const std::shared_ptr<JavaRTCDataChannelObserverClass> javaClass;
 	};
 }
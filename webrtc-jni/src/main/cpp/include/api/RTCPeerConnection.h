@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_RTC_PEER_CONNECTION_H_
+#define JNI_WEBRTC_API_RTC_PEER_CONNECTION_H_
+
+#include "api/RTCConfiguration.h"
+
+#include <jni.h>
+
+namespace jni
+{
+	namespace RTCPeerConnection
+	{
+		/*
+		 * Stores a copy of the creation options with the Java peer connection.
+		 */
+		void setOptions(JNIEnv * env, jobject javaType, const PeerConnectionOptions & options);
+
+		/*
+		 * Returns the creation options or nullptr if the peer connection has
+		 * been closed.
+		 */
+		const PeerConnectionOptions * getOptions(JNIEnv * env, jobject javaType);
+
+		/*
+		 * Takes the creation options from the closing peer connection. The
+		 * caller deletes them once the connection has been closed on the
+		 * signaling thread.
+		 */
+		PeerConnectionOptions * detachOptions(JNIEnv * env, jobject javaType);
+
+		bool isIceLite(JNIEnv * env, jobject javaType);
+		bool useSdpTemplate(JNIEnv * env, jobject javaType);
+	}
+}
+
+#endif
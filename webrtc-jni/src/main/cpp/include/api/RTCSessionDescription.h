@@ -39,8 +39,9 @@ namespace jni
 				jfieldID sdp;
 		};
 
-		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::SessionDescriptionInterface * nativeType);
-		std::unique_ptr<webrtc::SessionDescriptionInterface> toNative(JNIEnv * env, const JavaRef<jobject> & javaType);
+		// With sdpTemplate set, data channel only sessions use the SdpTemplate fast path.
+		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::SessionDescriptionInterface * nativeType, bool sdpTemplate = false);
+		std::unique_ptr<webrtc::SessionDescriptionInterface> toNative(JNIEnv * env, const JavaRef<jobject> & javaType, bool sdpTemplate = false);
 	}
 }
 
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_RTC_STATS_SERIALIZED_CALLBACK_H_
+#define JNI_WEBRTC_API_RTC_STATS_SERIALIZED_CALLBACK_H_
+
+#include "api/RTCStatsSerializer.h"
+#include "JavaClass.h"
+#include "JavaRef.h"
+
+#include "api/stats/rtc_stats_collector_callback.h"
+
+#include <jni.h>
+#include <memory>
+
+namespace jni
+{
+	class RTCStatsSerializedCallback : public webrtc::RTCStatsCollectorCallback
+	{
+		public:
+			RTCStatsSerializedCallback(JNIEnv * env, const JavaGlobalRef<jobject> & callback, RTCStatsSerializer::RTCStatsFormat format);
+			~RTCStatsSerializedCallback() = default;
+
+			void OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport> & report) override;
+
+		private:
+			class JavaRTCStatsSerializedCallbackClass : public JavaClass
+			{
+				public:
+					explicit JavaRTCStatsSerializedCallbackClass(JNIEnv * env);
+
+					jmethodID onStatsDelivered;
+			};
+
+		private:
+			JavaGlobalRef<jobject> callback;
+
+			const RTCStatsSerializer::RTCStatsFormat format;
+
+			const std::shared_ptr<JavaRTCStatsSerializedCallbackClass> javaClass;
+	};
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_RTC_STATS_SERIALIZER_H_
+#define JNI_WEBRTC_API_RTC_STATS_SERIALIZER_H_
+
+#include "api/stats/rtc_stats_report.h"
+
+#include <string>
+
+namespace jni
+{
+	namespace RTCStatsSerializer
+	{
+		enum class RTCStatsFormat {
+			kJson,
+			kBinary
+		};
+
+		/*
+		 * Serializes the whole report into a single buffer. The binary layout is
+		 * documented in dev.kastle.webrtc.RTCStatsFormat.
+		 */
+		std::string serialize(const webrtc::RTCStatsReport & report, RTCStatsFormat format);
+	}
+}
+
+#endif
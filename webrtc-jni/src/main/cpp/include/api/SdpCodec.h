@@ -0,0 +1,46 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_SDP_CODEC_H_
+#define JNI_WEBRTC_API_SDP_CODEC_H_
+
+#include "api/jsep.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace jni
+{
+	/*
+	 * Compact binary form of data channel session descriptions and ICE
+	 * candidates for signaling. Only the fields a data channel session needs
+	 * are kept: ICE credentials and options, the DTLS fingerprint and role,
+	 * the SCTP port, the maximum message size and the candidates. The layout
+	 * is documented in dev.kastle.webrtc.SdpCodec.
+	 */
+	namespace SdpCodec
+	{
+		std::vector<uint8_t> encodeDescription(const webrtc::SessionDescriptionInterface & desc);
+		std::unique_ptr<webrtc::SessionDescriptionInterface> decodeDescription(const uint8_t * data, std::size_t size);
+
+		std::vector<uint8_t> encodeCandidates(const std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> & candidates);
+		std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> decodeCandidates(const uint8_t * data, std::size_t size);
+	}
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_API_SDP_TEMPLATE_H_
+#define JNI_WEBRTC_API_SDP_TEMPLATE_H_
+
+#include "api/candidate.h"
+#include "api/jsep.h"
+#include "p2p/base/transport_description.h"
+#include "rtc_base/ssl_fingerprint.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jni
+{
+	/*
+	 * Fast path for the SDP of data channel only sessions. Such sessions
+	 * differ only in a handful of fields, so they are written from a fixed
+	 * template and parsed by matching that template, instead of running the
+	 * generic WebRTC serializer and parser. Anything that does not match the
+	 * template is handed to the generic implementation. Peer connections use
+	 * the template only if enabled in their RTCConfiguration.
+	 */
+	namespace SdpTemplate
+	{
+		struct DataSession
+		{
+			webrtc::SdpType type = webrtc::SdpType::kOffer;
+			std::string sessionId;
+			std::string sessionVersion;
+			bool extmapAllowMixed = false;
+			bool msidSemantic = false;
+			bool iceLite = false;
+			bool trickle = false;
+			std::string mid;
+			std::string ufrag;
+			std::string pwd;
+			webrtc::ConnectionRole role = webrtc::CONNECTIONROLE_NONE;
+			std::unique_ptr<webrtc::SSLFingerprint> fingerprint;
+			int sctpPort = 0;
+			int maxMessageSize = 0;
+			std::vector<webrtc::Candidate> candidates;
+		};
+
+		// Returns false if the description is not a single bundled data channel section.
+		bool extract(const webrtc::SessionDescriptionInterface & desc, DataSession & session);
+		// Returns false if the SDP does not match the data channel template.
+		bool match(webrtc::SdpType type, std::string_view sdp, DataSession & session);
+
+		std::string build(const DataSession & session);
+		std::unique_ptr<webrtc::SessionDescriptionInterface> create(const DataSession & session);
+
+		// Template fast path, if enabled, with fallback to the generic serializer and parser.
+		std::string serialize(const webrtc::SessionDescriptionInterface & desc, bool enabled);
+		std::unique_ptr<webrtc::SessionDescriptionInterface> deserialize(webrtc::SdpType type, const std::string & sdp, webrtc::SdpParseError * error, bool enabled);
+	}
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include "Exception.h"
 #include "JavaFactories.h"
 
+#include "api/jsep.h"
 #include "api/rtc_error.h"
 #include "api/scoped_refptr.h"
 
@@ -50,6 +51,11 @@ namespace jni
 	}
 
 	std::string RTCErrorToString(const webrtc::RTCError & error);
+
+	/*
+	 * Announces the ICE-lite mode in all transports of the description.
+	 */
+	void SetIceLiteMode(webrtc::SessionDescriptionInterface * desc);
 }
 
 #endif
\ No newline at end of file
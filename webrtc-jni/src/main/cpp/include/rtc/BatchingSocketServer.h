@@ -0,0 +1,154 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_RTC_BATCHING_SOCKET_SERVER_H_
+#define JNI_WEBRTC_RTC_BATCHING_SOCKET_SERVER_H_
+
+#if defined(WEBRTC_LINUX)
+
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/socket_address.h"
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace jni
+{
+	class BatchingSocketServer;
+
+	/*
+	 * A UDP socket that reads all pending datagrams with one recvmmsg call and
+	 * delivers the queued datagrams within the same network thread wakeup.
+	 *
+	 * With UDP offload enabled, received GRO buffers are split into their
+	 * segments, and consecutive equally sized datagrams to the same
+	 * destination are sent with one UDP_SEGMENT (GSO) sendmsg call at the end
+	 * of the current network thread task. A batch the kernel cannot take yet
+	 * is kept and retried once the socket becomes writable, meanwhile sends
+	 * fail with EWOULDBLOCK. Other errors of a deferred send are reported by
+	 * the next send.
+	 */
+	class BatchingSocketDispatcher : public webrtc::SocketDispatcher
+	{
+		public:
+			explicit BatchingSocketDispatcher(BatchingSocketServer * server);
+			~BatchingSocketDispatcher() override;
+
+			using webrtc::SocketDispatcher::Create;
+			bool Create(int family, int type) override;
+
+			int RecvFrom(void * buffer, size_t length, webrtc::SocketAddress * address, int64_t * timestamp) override;
+			int RecvFrom(ReceiveBuffer & buffer) override;
+
+			void OnEvent(uint32_t ff, int err) override;
+
+			int Close() override;
+
+		protected:
+			int DoSendTo(int socket, const char * buf, int len, int flags, const struct sockaddr * dest_addr, socklen_t addrlen) override;
+
+		private:
+			struct Datagram
+			{
+				webrtc::Buffer data;
+				webrtc::SocketAddress address;
+			};
+
+			bool fillQueue();
+			void enqueue(const uint8_t * data, size_t size, int segmentSize, const sockaddr_storage & address);
+
+			bool appendSegment(const char * buf, size_t len, const struct sockaddr * address, socklen_t addressLength);
+			// Returns false if the socket is not writable and the batch has been kept.
+			bool flushSegments();
+
+		private:
+			BatchingSocketServer * server;
+
+			std::deque<Datagram> queue;
+
+			bool gro;
+			bool gso;
+
+			// Pending GSO segments, all of segmentSize except for the last one.
+			std::vector<uint8_t> segments;
+			std::size_t segmentSize;
+			std::size_t segmentCount;
+			sockaddr_storage segmentAddress;
+			socklen_t segmentAddressLength;
+			bool segmentsClosed;
+			bool flushScheduled;
+			// Set while a batch waits for the socket to become writable.
+			bool blocked;
+			// The error of a failed deferred send, reported by the next send.
+			int sendError;
+
+			webrtc::ScopedTaskSafety safety;
+
+			// Cleared on destruction, since event handlers may delete the socket.
+			std::shared_ptr<bool> alive;
+	};
+
+	/*
+	 * A PhysicalSocketServer creating batching UDP sockets. The receive scratch
+	 * memory is shared by all sockets, since they are served by one thread.
+	 */
+	class BatchingSocketServer : public webrtc::PhysicalSocketServer
+	{
+		public:
+			static constexpr std::size_t kBatchSize = 32;
+			static constexpr std::size_t kMaxDatagramSize = 64 * 1024;
+			static constexpr std::size_t kControlSize = 64;
+
+			explicit BatchingSocketServer(bool udpOffload);
+			~BatchingSocketServer() override = default;
+
+			webrtc::Socket * CreateSocket(int family, int type) override;
+
+			// The number of datagrams sent with segmentation offload. May be read on any thread.
+			uint64_t getOffloadedDatagrams() const;
+
+			/*
+			 * Sends a segmented datagram over loopback to check whether the
+			 * kernel supports UDP segmentation offload.
+			 */
+			static bool isUdpOffloadSupported();
+
+		private:
+			friend class BatchingSocketDispatcher;
+
+			const bool udpOffload;
+
+			std::atomic<uint64_t> offloadedDatagrams { 0 };
+
+			std::vector<uint8_t> buffers;
+			std::vector<uint8_t> controls;
+			std::vector<mmsghdr> messages;
+			std::vector<iovec> vectors;
+			std::vector<sockaddr_storage> addresses;
+	};
+}
+
+#endif
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_RTC_FILTERING_NETWORK_MANAGER_H_
+#define JNI_WEBRTC_RTC_FILTERING_NETWORK_MANAGER_H_
+
+#include "api/environment/environment.h"
+#include "api/packet_socket_factory.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jni
+{
+	/*
+	 * Restricts the networks a peer connection gathers candidates on.
+	 * Interface entries are either interface names, optionally ending with a
+	 * '*' wildcard, or CIDR blocks like "10.0.0.0/8".
+	 */
+	struct NetworkFilter
+	{
+		std::vector<std::string> allowList;
+		std::vector<std::string> denyList;
+		// Bitmask of webrtc::AdapterType values to ignore.
+		int ignoreMask = 0;
+		bool disableIpv6 = false;
+		// Zero for no limit.
+		int maxNetworksPerInterface = 0;
+
+		bool isEmpty() const
+		{
+			return allowList.empty() && denyList.empty() && ignoreMask == 0 && !disableIpv6 && maxNetworksPerInterface <= 0;
+		}
+
+		bool operator==(const NetworkFilter &) const = default;
+	};
+
+	/*
+	 * Presents a filtered view of a NetworkManager shared by many peer
+	 * connections, so that the shared network list is enumerated once but
+	 * every connection only sees the networks it is configured to use.
+	 */
+	class FilteringNetworkManager : public webrtc::NetworkManager, public sigslot::has_slots<>
+	{
+		public:
+			FilteringNetworkManager(webrtc::NetworkManager * networkManager, const NetworkFilter & filter);
+			~FilteringNetworkManager() override = default;
+
+			void StartUpdating() override;
+			void StopUpdating() override;
+
+			std::vector<const webrtc::Network *> GetNetworks() const override;
+			std::vector<const webrtc::Network *> GetAnyAddressNetworks() override;
+
+			webrtc::MdnsResponderInterface * GetMdnsResponder() const override;
+			EnumerationPermission enumeration_permission() const override;
+			bool GetDefaultLocalAddress(int family, webrtc::IPAddress * ipaddr) const override;
+
+			// Throws an Exception if an interface entry of the filter is malformed.
+			static void validate(const NetworkFilter & filter);
+
+		private:
+			struct Matcher
+			{
+				std::string name;
+				bool wildcard = false;
+				webrtc::IPAddress prefix;
+				int prefixLength = -1;
+
+				bool matches(const webrtc::Network * network) const;
+			};
+
+			static Matcher parse(const std::string & entry);
+
+			std::vector<const webrtc::Network *> filter(const std::vector<const webrtc::Network *> & networks) const;
+			bool isAllowed(const webrtc::Network * network) const;
+
+			void onNetworksChanged();
+
+		private:
+			webrtc::NetworkManager * networkManager;
+
+			std::vector<Matcher> allowList;
+			std::vector<Matcher> denyList;
+
+			const int ignoreMask;
+			const bool disableIpv6;
+			const int maxNetworksPerInterface;
+
+			int startCount;
+	};
+
+	/*
+	 * Holds the filtering network manager of a FilteringPortAllocator. As a
+	 * base class it outlives the allocator's pooled sessions, which access
+	 * the network manager when they are destroyed.
+	 */
+	class FilteringNetworkManagerHolder
+	{
+		protected:
+			explicit FilteringNetworkManagerHolder(std::unique_ptr<FilteringNetworkManager> networkManager) :
+				filteringNetworkManager(std::move(networkManager))
+			{
+			}
+
+			std::unique_ptr<FilteringNetworkManager> filteringNetworkManager;
+	};
+
+	/*
+	 * BasicPortAllocator owning the filtered view of a shared network manager.
+	 */
+	class FilteringPortAllocator : private FilteringNetworkManagerHolder, public webrtc::BasicPortAllocator
+	{
+		public:
+			FilteringPortAllocator(const webrtc::Environment & env, std::unique_ptr<FilteringNetworkManager> networkManager, webrtc::PacketSocketFactory * socketFactory);
+			~FilteringPortAllocator() override = default;
+	};
+}
+
+#endif
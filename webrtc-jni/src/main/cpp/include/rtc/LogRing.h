@@ -0,0 +1,147 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_RTC_LOG_RING_H_
+#define JNI_WEBRTC_RTC_LOG_RING_H_
+
+#include "rtc_base/logging.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace jni
+{
+	struct LogRecord
+	{
+		webrtc::LoggingSeverity severity = webrtc::LS_NONE;
+		int64_t timestamp = 0;
+		int64_t threadId = 0;
+		std::string message;
+	};
+
+	/*
+	 * Bounded lock-free queue of log records with many producers and a single
+	 * consumer. Each slot carries a sequence number that tells producers and
+	 * the consumer whether the slot is free or filled for the current lap.
+	 */
+	class LogRing
+	{
+		public:
+			explicit LogRing(size_t capacity) :
+				slots(new Slot[RoundUp(capacity)]),
+				mask(RoundUp(capacity) - 1)
+			{
+				for (size_t i = 0; i <= mask; i++) {
+					slots[i].sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			// Returns false if the ring is full. Safe to call from any thread.
+			bool push(LogRecord && record)
+			{
+				size_t pos = enqueuePos.load(std::memory_order_relaxed);
+				Slot * slot;
+
+				while (true) {
+					slot = &slots[pos & mask];
+
+					size_t sequence = slot->sequence.load(std::memory_order_acquire);
+					intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+					if (diff == 0) {
+						if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+							break;
+						}
+					}
+					else if (diff < 0) {
+						return false;
+					}
+					else {
+						pos = enqueuePos.load(std::memory_order_relaxed);
+					}
+				}
+
+				slot->record = std::move(record);
+				slot->sequence.store(pos + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			// Returns false if the ring is empty. Must only be called by the consumer.
+			bool pop(LogRecord & record)
+			{
+				size_t pos = dequeuePos.load(std::memory_order_relaxed);
+				Slot & slot = slots[pos & mask];
+
+				size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+				if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0) {
+					return false;
+				}
+
+				record = std::move(slot.record);
+
+				dequeuePos.store(pos + 1, std::memory_order_relaxed);
+				slot.sequence.store(pos + mask + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			// Approximate number of queued records.
+			size_t size() const
+			{
+				size_t head = dequeuePos.load(std::memory_order_relaxed);
+				size_t tail = enqueuePos.load(std::memory_order_relaxed);
+
+				return tail > head ? tail - head : 0;
+			}
+
+			size_t capacity() const
+			{
+				return mask + 1;
+			}
+
+		private:
+			struct Slot
+			{
+				std::atomic<size_t> sequence;
+				LogRecord record;
+			};
+
+			static size_t RoundUp(size_t capacity)
+			{
+				size_t size = 1;
+
+				while (size < capacity) {
+					size <<= 1;
+				}
+
+				return size;
+			}
+
+		private:
+			const std::unique_ptr<Slot[]> slots;
+			const size_t mask;
+
+			alignas(64) std::atomic<size_t> enqueuePos { 0 };
+			alignas(64) std::atomic<size_t> dequeuePos { 0 };
+	};
+}
+
+#endif
@@ -17,40 +17,95 @@
 #ifndef JNI_WEBRTC_RTC_LOG_SINK_H_
 #define JNI_WEBRTC_RTC_LOG_SINK_H_
 
+#include "rtc/LogRing.h"
 #include "JavaClass.h"
 #include "JavaRef.h"
 
 #include "rtc_base/logging.h"
 
 #include <jni.h>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace jni
 {
+	struct LogSinkOptions
+	{
+		size_t capacity = 4096;
+		int flushInterval = 50;
+		int maxMessagesPerSecond = 0;
+		std::vector<std::string> excludedTags;
+	};
+
+	/*
+	 * Filters log messages on the logging thread and queues them in a LogRing.
+	 * A dedicated thread delivers the queued messages in batches to the Java
+	 * sink, so no JNI work is done on WebRTC threads.
+	 */
 	class LogSink : public webrtc::LogSink
 	{
 		public:
-			explicit LogSink(JNIEnv * env, const JavaGlobalRef<jobject> & javaSink);
-			~LogSink() = default;
+			explicit LogSink(JNIEnv * env, const JavaGlobalRef<jobject> & javaSink, const LogSinkOptions & options);
+			~LogSink();
 
 			// LogSink implementation.
 			void OnLogMessage(const std::string & message) override;
 			void OnLogMessage(const std::string & message, webrtc::LoggingSeverity severity) override;
 
+			// Returns true if this sink delivers to the given Java sink.
+			bool delivers(JNIEnv * env, jobject sink) const;
+
+		private:
+			bool accept(const std::string & message);
+			void run();
+			void flush(JNIEnv * env);
+
 		private:
 			class JavaLogSinkClass : public JavaClass
 			{
 				public:
 					explicit JavaLogSinkClass(JNIEnv * env);
 
-					jmethodID onLogMessage;
+					jmethodID onLogMessages;
+			};
+
+			class JavaLogRecordClass : public JavaClass
+			{
+				public:
+					explicit JavaLogRecordClass(JNIEnv * env);
+
+					jclass cls;
+					jmethodID ctor;
 			};
 
 		private:
 			JavaGlobalRef<jobject> javaSink;
 
+			const LogSinkOptions options;
+
+			LogRing ring;
+
+			std::atomic<uint64_t> dropped;
+
+			std::atomic<int64_t> rateWindow;
+			std::atomic<int> rateCount;
+
+			std::mutex mutex;
+			std::condition_variable wakeup;
+			bool running;
+
+			std::vector<JavaGlobalRef<jobject>> severities;
+
 			const std::shared_ptr<JavaLogSinkClass> javaClass;
+			const std::shared_ptr<JavaLogRecordClass> javaRecordClass;
+
+			std::thread thread;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
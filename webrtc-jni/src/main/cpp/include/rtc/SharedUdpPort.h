@@ -0,0 +1,240 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JNI_WEBRTC_RTC_SHARED_UDP_PORT_H_
+#define JNI_WEBRTC_RTC_SHARED_UDP_PORT_H_
+
+#include "absl/strings/string_view.h"
+#include "api/environment/environment.h"
+#include "api/packet_socket_factory.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/socket_factory.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc/FilteringNetworkManager.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace jni
+{
+	class SharedUdpSocket;
+
+	/*
+	 * One UDP port shared by the ICE ports of all peer connections of a
+	 * factory shard. A single socket is bound per local IP address and
+	 * inbound datagrams are demultiplexed to the per-connection sockets.
+	 * STUN responses are matched to the socket that sent the request by
+	 * transaction ID, inbound STUN binding requests by the local ICE ufrag in
+	 * their USERNAME and all other datagrams by remote address. Must only be
+	 * used on the network thread.
+	 */
+	class SharedUdpPort : public sigslot::has_slots<>, public std::enable_shared_from_this<SharedUdpPort>
+	{
+		public:
+			SharedUdpPort(webrtc::SocketFactory * socketFactory, uint16_t port);
+			~SharedUdpPort() override;
+
+			/*
+			 * Creates a socket for the ICE ports of the given owner, i.e. the
+			 * port allocator of a single peer connection.
+			 */
+			webrtc::AsyncPacketSocket * createSocket(const webrtc::SocketAddress & address, const void * owner);
+
+			/*
+			 * Registers the local ICE ufrag of an allocator session, so that
+			 * binding requests are routed before the connection sent any.
+			 */
+			void addUfrag(const std::string & ufrag, const void * owner);
+			void removeUfrag(const std::string & ufrag, const void * owner);
+
+		private:
+			friend class SharedUdpSocket;
+
+			struct Transaction
+			{
+				SharedUdpSocket * socket;
+				int64_t timeMs;
+			};
+
+			struct Endpoint
+			{
+				std::unique_ptr<webrtc::AsyncPacketSocket> socket;
+				std::set<SharedUdpSocket *> sockets;
+				std::map<webrtc::SocketAddress, SharedUdpSocket *> remotes;
+				std::map<std::string, SharedUdpSocket *> ufrags;
+				std::map<std::string, Transaction> transactions;
+				SharedUdpSocket * sending = nullptr;
+			};
+
+			int sendTo(SharedUdpSocket * socket, const void * data, size_t size, const webrtc::SocketAddress & address, const webrtc::AsyncSocketPacketOptions & options);
+			void remove(SharedUdpSocket * socket);
+
+			void onPacketReceived(Endpoint * endpoint, const webrtc::ReceivedIpPacket & packet);
+			void onSentPacket(webrtc::AsyncPacketSocket * socket, const webrtc::SentPacketInfo & info);
+			void onReadyToSend(webrtc::AsyncPacketSocket * socket);
+
+			Endpoint * findEndpoint(webrtc::AsyncPacketSocket * socket);
+
+			SharedUdpSocket * findByUfrag(Endpoint * endpoint, const std::string & ufrag);
+
+			void addTransaction(Endpoint * endpoint, const std::string & id, SharedUdpSocket * socket);
+
+		private:
+			webrtc::BasicPacketSocketFactory factory;
+
+			const uint16_t port;
+
+			std::map<webrtc::IPAddress, std::unique_ptr<Endpoint>> endpoints;
+
+			// Local ufrags of the allocator sessions by owner.
+			std::map<std::string, const void *> localUfrags;
+
+			// Creation order of the sockets, the newest socket of an owner
+			// belongs to its most recent session.
+			uint64_t socketSequence;
+	};
+
+	/*
+	 * The socket handed to a single ICE port, backed by a SharedUdpPort.
+	 */
+	class SharedUdpSocket : public webrtc::AsyncPacketSocket
+	{
+		public:
+			SharedUdpSocket(const std::shared_ptr<SharedUdpPort> & port, webrtc::AsyncPacketSocket * socket, const void * owner, uint64_t sequence);
+			~SharedUdpSocket() override;
+
+			webrtc::SocketAddress GetLocalAddress() const override;
+			webrtc::SocketAddress GetRemoteAddress() const override;
+
+			int Send(const void * data, size_t size, const webrtc::AsyncSocketPacketOptions & options) override;
+			int SendTo(const void * data, size_t size, const webrtc::SocketAddress & address, const webrtc::AsyncSocketPacketOptions & options) override;
+
+			int Close() override;
+
+			State GetState() const override;
+
+			int GetOption(webrtc::Socket::Option option, int * value) override;
+			int SetOption(webrtc::Socket::Option option, int value) override;
+
+			int GetError() const override;
+			void SetError(int error) override;
+
+		private:
+			friend class SharedUdpPort;
+
+			void deliver(const webrtc::ReceivedIpPacket & packet);
+
+		private:
+			// Keeps the shared port alive while this socket exists.
+			std::shared_ptr<SharedUdpPort> port;
+
+			webrtc::AsyncPacketSocket * socket;
+
+			const void * owner;
+
+			const uint64_t sequence;
+
+			State state;
+
+			int error;
+	};
+
+	/*
+	 * Per peer connection socket factory creating UDP sockets on a shared
+	 * port. TCP sockets and DNS resolution use the regular implementation.
+	 */
+	class SharedUdpPacketSocketFactory : public webrtc::BasicPacketSocketFactory
+	{
+		public:
+			SharedUdpPacketSocketFactory(webrtc::SocketFactory * socketFactory, const std::shared_ptr<SharedUdpPort> & port);
+			~SharedUdpPacketSocketFactory() override = default;
+
+			webrtc::AsyncPacketSocket * CreateUdpSocket(const webrtc::SocketAddress & address, uint16_t minPort, uint16_t maxPort) override;
+
+			const std::shared_ptr<SharedUdpPort> & getPort() const
+			{
+				return port;
+			}
+
+		private:
+			std::shared_ptr<SharedUdpPort> port;
+	};
+
+	/*
+	 * Allocator session registering its local ICE ufrag with the shared
+	 * port for as long as it exists.
+	 */
+	class SharedUdpPortAllocatorSession : public webrtc::BasicPortAllocatorSession
+	{
+		public:
+			SharedUdpPortAllocatorSession(webrtc::BasicPortAllocator * allocator, SharedUdpPacketSocketFactory * socketFactory,
+				absl::string_view contentName, int component, absl::string_view ufrag, absl::string_view pwd);
+			~SharedUdpPortAllocatorSession() override;
+
+		protected:
+			void UpdateIceParametersInternal() override;
+
+		private:
+			// Keeps the registry of the port alive until the ufrag is removed.
+			std::shared_ptr<SharedUdpPort> port;
+
+			const void * owner;
+
+			std::string ufrag;
+	};
+
+	/*
+	 * Holds the socket factory of a SharedUdpPortAllocator, so that it
+	 * outlives the allocator's pooled sessions.
+	 */
+	class SharedUdpSocketFactoryHolder
+	{
+		protected:
+			explicit SharedUdpSocketFactoryHolder(std::unique_ptr<SharedUdpPacketSocketFactory> socketFactory) :
+				sharedUdpSocketFactory(std::move(socketFactory))
+			{
+			}
+
+			std::unique_ptr<SharedUdpPacketSocketFactory> sharedUdpSocketFactory;
+	};
+
+	/*
+	 * BasicPortAllocator gathering UDP candidates on a shared port. Owns the
+	 * filtered view of the network manager, if the connection has one.
+	 */
+	class SharedUdpPortAllocator : private FilteringNetworkManagerHolder, private SharedUdpSocketFactoryHolder, public webrtc::BasicPortAllocator
+	{
+		public:
+			SharedUdpPortAllocator(const webrtc::Environment & env, webrtc::NetworkManager * networkManager,
+				std::unique_ptr<FilteringNetworkManager> filteringNetworkManager, std::unique_ptr<SharedUdpPacketSocketFactory> socketFactory);
+			~SharedUdpPortAllocator() override = default;
+
+		protected:
+			webrtc::PortAllocatorSession * CreateSessionInternal(absl::string_view contentName, int component,
+				absl::string_view ufrag, absl::string_view pwd) override;
+	};
+}
+
+#endif
@@ -16,25 +16,22 @@
 
 #include "JNI_Logging.h"
 #include "rtc/LogSink.h"
+#include "rtc/LogSinkConfig.h"
 #include "JavaEnums.h"
+#include "JavaNullPointerException.h"
 #include "JavaRef.h"
 #include "JavaString.h"
 #include "JavaUtils.h"
 
 #include "rtc_base/logging.h"
 
-JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_addLogSink
-(JNIEnv * env, jclass caller, jobject jseverity, jobject jsink)
-{
-	try {
-		auto severity = jni::JavaEnums::toNative<webrtc::LoggingSeverity>(env, jseverity);
+#include <algorithm>
+#include <mutex>
+#include <vector>
 
-		webrtc::LogMessage::AddLogToStream(new jni::LogSink(env, jni::JavaGlobalRef<jobject>(env, jsink)), severity);
-	}
-	catch (...) {
-		ThrowCxxJavaException(env);
-	}
-}
+// Sinks added from Java, kept to remove them again.
+static std::mutex sinksMutex;
+static std::vector<jni::LogSink *> sinks;
 
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_log
 (JNIEnv * env, jclass caller, jobject jseverity, jstring jmessage)
@@ -66,4 +63,55 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_logTimestamps
 (JNIEnv * env, jclass caller, jboolean enable)
 {
 	webrtc::LogMessage::LogTimestamps(static_cast<bool>(enable));
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_addLogSinkConfig
+(JNIEnv * env, jclass caller, jobject jseverity, jobject jsink, jobject jconfig)
+{
+	try {
+		auto severity = jni::JavaEnums::toNative<webrtc::LoggingSeverity>(env, jseverity);
+		auto options = jni::LogSinkConfig::toNative(env, jni::JavaLocalRef<jobject>(env, jconfig));
+
+		auto sink = new jni::LogSink(env, jni::JavaGlobalRef<jobject>(env, jsink), options);
+
+		std::lock_guard<std::mutex> lock(sinksMutex);
+
+		sinks.push_back(sink);
+
+		// Messages below the severity are discarded by WebRTC before they are formatted.
+		webrtc::LogMessage::AddLogToStream(sink, severity);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_logging_Logging_removeLogSink
+(JNIEnv * env, jclass caller, jobject jsink)
+{
+	if (jsink == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "LogSink must not be null"));
+		return;
+	}
+
+	std::vector<jni::LogSink *> removed;
+
+	{
+		std::lock_guard<std::mutex> lock(sinksMutex);
+
+		auto it = std::stable_partition(sinks.begin(), sinks.end(), [env, jsink](jni::LogSink * sink) {
+			return !sink->delivers(env, jsink);
+		});
+
+		removed.assign(it, sinks.end());
+		sinks.erase(it, sinks.end());
+	}
+
+	for (jni::LogSink * sink : removed) {
+		// No message is delivered to the sink once this returns.
+		webrtc::LogMessage::RemoveLogToStream(sink);
+
+		// Delivers the queued messages and stops the delivery thread.
+		delete sink;
+	}
 }
\ No newline at end of file
@@ -15,119 +15,262 @@
  */
 
 #include "JNI_PeerConnectionFactory.h"
+#include "api/CompiledRTCConfiguration.h"
+#include "api/CompiledRTCDataChannelInit.h"
+#include "api/PeerConnectionFactoryConfig.h"
+#include "api/FutureObservers.h"
 #include "api/PeerConnectionObserver.h"
+#include "api/RTCCertificateRef.h"
 #include "api/RTCConfiguration.h"
+#include "api/RTCDataChannelInit.h"
+#include "api/RTCPeerConnection.h"
+#include "ShardedPeerConnectionFactory.h"
+#include "JavaEnums.h"
 #include "JavaError.h"
 #include "JavaFactories.h"
+#include "JavaIllegalArgumentException.h"
 #include "JavaNullPointerException.h"
 #include "JavaRuntimeException.h"
 #include "JavaUtils.h"
 
+#include "api/make_ref_counted.h"
+#include "rtc_base/rtc_certificate_generator.h"
+#include "rtc_base/ssl_identity.h"
+
+#include <optional>
+
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_initialize
-(JNIEnv * env, jobject caller)
+(JNIEnv * env, jobject caller, jobject jConfig)
 {
-    std::unique_ptr<webrtc::Thread> networkThread = webrtc::Thread::CreateWithSocketServer();
-    networkThread->SetName("webrtc_jni_network_thread", nullptr);
-    if (!networkThread->Start()) {
-        env->Throw(jni::JavaRuntimeException(env, "Start network thread failed"));
-        return;
-    }
-    SetHandle(env, caller, "networkThreadHandle", networkThread.get());
-
-    std::unique_ptr<webrtc::Thread> signalingThread = webrtc::Thread::Create();
-    signalingThread->SetName("webrtc_jni_signaling_thread", nullptr);
-    if (!signalingThread->Start()) {
-        env->Throw(jni::JavaRuntimeException(env, "Start signaling thread failed"));
-        return;
-    }
-    SetHandle(env, caller, "signalingThreadHandle", signalingThread.get());
-
-    std::unique_ptr<webrtc::Thread> workerThread = webrtc::Thread::Create();
-    workerThread->SetName("webrtc_jni_worker_thread", nullptr);
-    if (!workerThread->Start()) {
-        env->Throw(jni::JavaRuntimeException(env, "Start worker thread failed"));
-        return;
-    }
-    SetHandle(env, caller, "workerThreadHandle", workerThread.get());
-
-    webrtc::PeerConnectionFactoryDependencies dependencies;
-    
-    dependencies.network_thread = networkThread.release();
-    dependencies.worker_thread = workerThread.release();
-    dependencies.signaling_thread = signalingThread.release();
-
-    webrtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory = 
-        webrtc::CreateModularPeerConnectionFactory(std::move(dependencies));
-
-    if (factory == nullptr) {
-        env->Throw(jni::JavaRuntimeException(env, "Create PeerConnectionFactory failed"));
-        return;
-    }
-
-    SetHandle(env, caller, factory.release());
+	if (jConfig == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "PeerConnectionFactoryConfig is null"));
+		return;
+	}
+
+	try {
+		jni::PeerConnectionFactoryOptions options =
+			jni::PeerConnectionFactoryConfig::toNative(env, jni::JavaLocalRef<jobject>(env, jConfig));
+
+		SetHandle(env, caller, new jni::ShardedPeerConnectionFactory(options));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
 }
 
-JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_dispose
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_disposeFactory
 (JNIEnv * env, jobject caller)
 {
-	webrtc::PeerConnectionFactoryInterface * factory = GetHandle<webrtc::PeerConnectionFactoryInterface>(env, caller);
+	jni::ShardedPeerConnectionFactory * factory = GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
 	CHECK_HANDLE(factory);
 
-	std::unique_ptr<webrtc::Thread> networkThread(GetHandle<webrtc::Thread>(env, caller, "networkThreadHandle"));
-	std::unique_ptr<webrtc::Thread> signalingThread(GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle"));
-	std::unique_ptr<webrtc::Thread> workerThread(GetHandle<webrtc::Thread>(env, caller, "workerThreadHandle"));
+	SetHandle<std::nullptr_t>(env, caller, nullptr);
+
+	bool released = factory->dispose();
 
-	webrtc::RefCountReleaseStatus status = factory->Release();
+	delete factory;
 
-	if (status != webrtc::RefCountReleaseStatus::kDroppedLastRef) {
+	if (!released) {
 		env->Throw(jni::JavaError(
             env, 
             "Native object was not deleted. A reference is still around somewhere."
         ));
 	}
+}
 
-	SetHandle<std::nullptr_t>(env, caller, nullptr);
-	factory = nullptr;
-
-    if (networkThread) {
-        networkThread->Stop();
-    }
-    if (signalingThread) {
-        signalingThread->Stop();
-    }
-    if (workerThread) {
-        workerThread->Stop();
-    }
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_flushSignalingThreads
+(JNIEnv * env, jobject caller)
+{
+	jni::ShardedPeerConnectionFactory * factory = GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
+	CHECK_HANDLE(factory);
+
+	try {
+		factory->flushSignalingThreads();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
 }
 
-JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_createPeerConnection
-(JNIEnv * env, jobject caller, jobject jConfig, jobject jobserver)
+JNIEXPORT jintArray JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_getShardLoad
+(JNIEnv * env, jobject caller)
 {
-	if (jConfig == nullptr) {
-		env->Throw(jni::JavaNullPointerException(env, "RTCConfiguration is null"));
+	jni::ShardedPeerConnectionFactory * factory = GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
+	CHECK_HANDLEV(factory, nullptr);
+
+	std::vector<int> load = factory->getLoad();
+	const jsize length = static_cast<jsize>(load.size());
+
+	jintArray array = env->NewIntArray(length);
+
+	if (array != nullptr) {
+		std::vector<jint> values(load.begin(), load.end());
+
+		env->SetIntArrayRegion(array, 0, length, values.data());
+	}
+
+	return array;
+}
+
+JNIEXPORT jlong JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_getOffloadedDatagrams
+(JNIEnv * env, jobject caller)
+{
+	jni::ShardedPeerConnectionFactory * factory = GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
+	CHECK_HANDLEV(factory, 0);
+
+	return static_cast<jlong>(factory->getOffloadedDatagrams());
+}
+
+JNIEXPORT jboolean JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_isUdpOffloadSupported
+(JNIEnv * env, jclass caller)
+{
+	return static_cast<jboolean>(jni::ShardedPeerConnectionFactory::isUdpOffloadSupported());
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_generateCertificate
+(JNIEnv * env, jobject caller, jobject jKeyType, jlong expiresMs)
+{
+	if (jKeyType == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCKeyType must not be null"));
 		return nullptr;
 	}
-	if (jobserver == nullptr) {
-		env->Throw(jni::JavaNullPointerException(env, "PeerConnectionObserver is null"));
+
+	try {
+		auto keyType = jni::JavaEnums::toNative<webrtc::KeyType>(env, jKeyType);
+
+		std::optional<uint64_t> expires;
+
+		if (expiresMs > 0) {
+			expires = static_cast<uint64_t>(expiresMs);
+		}
+
+		// Thread-safe, key generation runs on the calling thread.
+		webrtc::scoped_refptr<webrtc::RTCCertificate> certificate =
+			webrtc::RTCCertificateGenerator::GenerateCertificate(webrtc::KeyParams(keyType), expires);
+
+		if (certificate == nullptr) {
+			env->Throw(jni::JavaRuntimeException(env, "Generate certificate failed"));
+			return nullptr;
+		}
+
+		auto ref = webrtc::make_ref_counted<jni::RTCCertificateRef>(std::move(certificate));
+
+		return jni::JavaFactories::create(env, ref.release()).release();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_generateCertificateFuture
+(JNIEnv * env, jobject caller, jobject jKeyType, jlong expiresMs, jobject jFuture)
+{
+	if (jKeyType == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCKeyType must not be null"));
+		return;
+	}
+
+	jni::ShardedPeerConnectionFactory * factory = GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
+	CHECK_HANDLE(factory);
+
+	try {
+		auto keyType = jni::JavaEnums::toNative<webrtc::KeyType>(env, jKeyType);
+
+		std::optional<uint64_t> expires;
+
+		if (expiresMs > 0) {
+			expires = static_cast<uint64_t>(expiresMs);
+		}
+
+		auto future = std::make_shared<jni::JavaFuture>(env, jni::JavaGlobalRef<jobject>(env, jFuture));
+
+		// Generated on the worker thread, completed on the signaling thread.
+		factory->generateCertificate(webrtc::KeyParams(keyType), expires,
+			[future](webrtc::RTCErrorOr<webrtc::scoped_refptr<webrtc::RTCCertificate>> result) {
+				JNIEnv * env = AttachCurrentThread();
+
+				if (!result.ok()) {
+					future->fail(env, result.error());
+					return;
+				}
+
+				auto ref = webrtc::make_ref_counted<jni::RTCCertificateRef>(result.MoveValue());
+
+				future->complete(env, jni::JavaFactories::create(env, ref.release()).get());
+			});
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT jboolean JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_processMessages
+(JNIEnv * env, jobject caller, jint timeoutMs)
+{
+	jni::ShardedPeerConnectionFactory * factory = GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
+	CHECK_HANDLEV(factory, false);
+
+	try {
+		return static_cast<jboolean>(factory->processMessages(static_cast<int>(timeoutMs)));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return false;
+}
+
+static jobject CreatePeerConnection(JNIEnv * env, jobject caller, const jni::PeerConnectionConfiguration & config, jobject jobserver)
+{
+	jni::ShardedPeerConnectionFactory * shardedFactory = 
+        GetHandle<jni::ShardedPeerConnectionFactory>(env, caller);
+	CHECK_HANDLEV(shardedFactory, nullptr);
+
+	if (config.options.sharedUdpPort < 0 || config.options.sharedUdpPort > 65535) {
+		env->Throw(jni::JavaRuntimeException(env, "Invalid shared UDP port: %d", config.options.sharedUdpPort));
+		return nullptr;
+	}
+	if (config.options.sharedUdpPort != 0 && shardedFactory->getShardCount() > 1) {
+		// Each shard would bind the port on its own network thread.
+		env->Throw(jni::JavaIllegalArgumentException(env, "A shared UDP port requires a factory with exactly one shard"));
 		return nullptr;
 	}
 
-	webrtc::PeerConnectionFactoryInterface * factory = 
-        GetHandle<webrtc::PeerConnectionFactoryInterface>(env, caller);
-	CHECK_HANDLEV(factory, nullptr);
+	jni::PeerConnectionFactoryShard * shard = shardedFactory->selectShard();
+	jni::PeerConnectionShardLoad * load = shard->getLoad();
 
-	webrtc::PeerConnectionInterface::RTCConfiguration configuration = 
-        jni::RTCConfiguration::toNative(env, jni::JavaLocalRef<jobject>(env, jConfig));
+	webrtc::PeerConnectionFactoryInterface * factory = shard->getFactory();
+
+	if (factory == nullptr) {
+		load->decrement();
+		env->Throw(jni::JavaNullPointerException(env, "Object handle is null"));
+		return nullptr;
+	}
 
-	webrtc::PeerConnectionObserver * observer = 
-        new jni::PeerConnectionObserver(env, jni::JavaGlobalRef<jobject>(env, jobserver));
+	jni::PeerConnectionObserver * observer = 
+        new jni::PeerConnectionObserver(env, jni::JavaGlobalRef<jobject>(env, jobserver), config.options.iceCandidateBatchWindow);
 
 	webrtc::PeerConnectionDependencies dependencies(observer);
 
+	try {
+		dependencies.allocator = shard->createPortAllocator(static_cast<uint16_t>(config.options.sharedUdpPort), config.options.networkFilter);
+	}
+	catch (...) {
+		load->decrement();
+		delete observer;
+		ThrowCxxJavaException(env);
+		return nullptr;
+	}
+
     webrtc::RTCErrorOr<webrtc::scoped_refptr<webrtc::PeerConnectionInterface>> result = 
-        factory->CreatePeerConnectionOrError(configuration, std::move(dependencies));
+        factory->CreatePeerConnectionOrError(config.configuration, std::move(dependencies));
 
 	if (!result.ok()) {
+		load->decrement();
+		delete observer;
+
 		env->Throw(jni::JavaRuntimeException(env, "Create PeerConnection failed: %s %s",
 			ToString(result.error().type()), result.error().message()));
 
@@ -140,8 +283,105 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_createPee
 		jni::JavaLocalRef<jobject> javaPeerConnection = 
             jni::JavaFactories::create(env, pc.release());
 		SetHandle(env, javaPeerConnection.get(), "observerHandle", observer);
+
+		jni::RTCPeerConnection::setOptions(env, javaPeerConnection.get(), config.options);
+
+		// The slot has been reserved by selectShard.
+		load->AddRef();
+
+		SetHandle(env, javaPeerConnection.get(), "shardLoadHandle", load);
+		SetHandle(env, javaPeerConnection.get(), "signalingThreadHandle", shard->getSignalingThread());
+
 		return javaPeerConnection.release();
 	}
 
+	load->decrement();
+	delete observer;
+
+	return nullptr;
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_createPeerConnection
+(JNIEnv * env, jobject caller, jobject jConfig, jobject jobserver)
+{
+	if (jConfig == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCConfiguration is null"));
+		return nullptr;
+	}
+	if (jobserver == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "PeerConnectionObserver is null"));
+		return nullptr;
+	}
+
+	jni::PeerConnectionConfiguration config;
+
+	try {
+		config = jni::RTCConfiguration::toPeerConnectionConfiguration(env, jni::JavaLocalRef<jobject>(env, jConfig));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+		return nullptr;
+	}
+
+	return CreatePeerConnection(env, caller, config, jobserver);
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_createPeerConnectionCompiled
+(JNIEnv * env, jobject caller, jobject jConfig, jobject jobserver)
+{
+	if (jConfig == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "CompiledRTCConfiguration is null"));
+		return nullptr;
+	}
+	if (jobserver == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "PeerConnectionObserver is null"));
+		return nullptr;
+	}
+
+	auto compiled = static_cast<jni::CompiledRTCConfiguration *>(GetHandle<webrtc::RefCountInterface>(env, jConfig));
+	CHECK_HANDLEV(compiled, nullptr);
+
+	return CreatePeerConnection(env, caller, compiled->get(), jobserver);
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_compileConfiguration
+(JNIEnv * env, jobject caller, jobject jConfig)
+{
+	if (jConfig == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCConfiguration is null"));
+		return nullptr;
+	}
+
+	try {
+		auto compiled = webrtc::make_ref_counted<jni::CompiledRTCConfiguration>(
+			jni::RTCConfiguration::toPeerConnectionConfiguration(env, jni::JavaLocalRef<jobject>(env, jConfig)));
+
+		return jni::JavaFactories::create(env, compiled.release()).release();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_PeerConnectionFactory_compileDataChannelInit
+(JNIEnv * env, jobject caller, jobject jDict)
+{
+	if (jDict == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCDataChannelInit is null"));
+		return nullptr;
+	}
+
+	try {
+		auto compiled = webrtc::make_ref_counted<jni::CompiledRTCDataChannelInit>(
+			jni::RTCDataChannelInit::toNative(env, jni::JavaLocalRef<jobject>(env, jDict)));
+
+		return jni::JavaFactories::create(env, compiled.release()).release();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
 	return nullptr;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JNI_RTCCertificate.h"
+#include "api/RTCCertificateRef.h"
+#include "rtc/RTCCertificatePEM.h"
+#include "JavaClasses.h"
+#include "JavaObject.h"
+#include "JavaRef.h"
+#include "JavaUtils.h"
+#include "JNI_WebRTC.h"
+
+#include "rtc_base/rtc_certificate.h"
+
+JNIEXPORT jlong JNICALL Java_dev_kastle_webrtc_RTCCertificate_getExpires
+(JNIEnv * env, jobject caller)
+{
+	auto ref = static_cast<jni::RTCCertificateRef *>(GetHandle<webrtc::RefCountInterface>(env, caller));
+	CHECK_HANDLEV(ref, 0);
+
+	const auto & certificate = ref->get();
+
+	return static_cast<jlong>(certificate->Expires());
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCCertificate_toPEM
+(JNIEnv * env, jobject caller)
+{
+	auto ref = static_cast<jni::RTCCertificateRef *>(GetHandle<webrtc::RefCountInterface>(env, caller));
+	CHECK_HANDLEV(ref, nullptr);
+
+	const auto & certificate = ref->get();
+
+	jni::JavaLocalRef<jobject> pem = jni::RTCCertificatePEM::toJava(env, certificate->ToPEM());
+
+	const auto javaClass = jni::JavaClasses::get<jni::RTCCertificatePEM::JavaRTCCertificatePEMClass>(env);
+
+	jni::JavaObject obj(env, pem);
+	obj.setLong(javaClass->expires, static_cast<jlong>(certificate->Expires()));
+
+	return pem.release();
+}
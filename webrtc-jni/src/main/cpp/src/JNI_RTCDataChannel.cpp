@@ -15,14 +15,44 @@
  */
 
 #include "JNI_RTCDataChannel.h"
+#include "api/RTCDataChannelCounters.h"
+#include "api/RTCDataChannelDrain.h"
 #include "api/RTCDataChannelObserver.h"
 #include "JavaEnums.h"
 #include "JavaError.h"
+#include "JavaPrimitive.h"
 #include "JavaRef.h"
+#include "JavaRuntimeException.h"
 #include "JavaString.h"
 #include "JavaUtils.h"
 
 #include "api/data_channel_interface.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread.h"
+
+static void CountSentMessage(JNIEnv * env, jobject caller, uint64_t size)
+{
+	jni::RTCDataChannelCounters * counters = GetHandle<jni::RTCDataChannelCounters>(env, caller, "countersHandle");
+
+	if (counters) {
+		counters->messageSent(size);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_initialize
+(JNIEnv * env, jobject caller)
+{
+	auto counters = new webrtc::RefCountedObject<jni::RTCDataChannelCounters>();
+	counters->AddRef();
+
+	SetHandle<jni::RTCDataChannelCounters>(env, caller, "countersHandle", counters);
+
+	auto drain = new webrtc::RefCountedObject<jni::RTCDataChannelDrain>();
+	drain->AddRef();
+
+	SetHandle<jni::RTCDataChannelDrain>(env, caller, "drainHandle", drain);
+}
 
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_registerObserver
 (JNIEnv * env, jobject caller, jobject jObserver)
@@ -30,7 +60,14 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_registerObserver
 	webrtc::DataChannelInterface * channel = GetHandle<webrtc::DataChannelInterface>(env, caller);
 	CHECK_HANDLE(channel);
 
-	channel->RegisterObserver(new jni::RTCDataChannelObserver(env, jni::JavaGlobalRef<jobject>(env, jObserver)));
+	webrtc::scoped_refptr<jni::RTCDataChannelCounters> counters(GetHandle<jni::RTCDataChannelCounters>(env, caller, "countersHandle"));
+	webrtc::scoped_refptr<jni::RTCDataChannelDrain> drain(GetHandle<jni::RTCDataChannelDrain>(env, caller, "drainHandle"));
+
+	auto observer = new jni::RTCDataChannelObserver(env, jni::JavaGlobalRef<jobject>(env, jObserver), counters, drain);
+
+	channel->RegisterObserver(observer);
+
+	SetHandle<jni::RTCDataChannelObserver>(env, caller, "observerHandle", observer);
 }
 
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_unregisterObserver
@@ -40,6 +77,8 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_unregisterObserver
 	CHECK_HANDLE(channel);
 
 	channel->UnregisterObserver();
+
+	SetHandle<std::nullptr_t>(env, caller, "observerHandle", nullptr);
 }
 
 JNIEXPORT jstring JNICALL Java_dev_kastle_webrtc_RTCDataChannel_getLabel
@@ -132,6 +171,29 @@ JNIEXPORT jlong JNICALL Java_dev_kastle_webrtc_RTCDataChannel_getBufferedAmount
 	return static_cast<jlong>(channel->buffered_amount());
 }
 
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_getCounters
+(JNIEnv * env, jobject caller, jlongArray jCounters)
+{
+	if (jCounters == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "Counter array must not be null"));
+		return;
+	}
+	if (env->GetArrayLength(jCounters) < jni::RTCDataChannelCounters::kCount) {
+		env->Throw(jni::JavaRuntimeException(env, "Counter array must have a length of at least %d",
+			jni::RTCDataChannelCounters::kCount));
+		return;
+	}
+
+	jni::RTCDataChannelCounters * counters = GetHandle<jni::RTCDataChannelCounters>(env, caller, "countersHandle");
+	CHECK_HANDLE(counters);
+
+	jlong values[jni::RTCDataChannelCounters::kCount];
+
+	counters->copyTo(values);
+
+	env->SetLongArrayRegion(jCounters, 0, jni::RTCDataChannelCounters::kCount, values);
+}
+
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_close
 (JNIEnv * env, jobject caller)
 {
@@ -141,12 +203,78 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_close
 	channel->Close();
 }
 
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_closeWhenDrainedFuture
+(JNIEnv * env, jobject caller, jlong timeoutMs, jobject jFuture)
+{
+	webrtc::DataChannelInterface * channel = GetHandle<webrtc::DataChannelInterface>(env, caller);
+	CHECK_HANDLE(channel);
+
+	webrtc::scoped_refptr<jni::RTCDataChannelDrain> drain(GetHandle<jni::RTCDataChannelDrain>(env, caller, "drainHandle"));
+	CHECK_HANDLE(drain);
+
+	try {
+		webrtc::Thread * signalingThread = GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle");
+
+		if (signalingThread == nullptr) {
+			// No thread to schedule the deadline on, close right away.
+			jni::JavaFuture future(env, jni::JavaGlobalRef<jobject>(env, jFuture));
+
+			const bool drained = channel->buffered_amount() == 0;
+
+			channel->Close();
+
+			jni::JavaLocalRef<jobject> result = jni::Boolean::create(env, drained);
+
+			future.complete(env, result.get());
+			return;
+		}
+
+		if (GetHandle<jni::RTCDataChannelObserver>(env, caller, "observerHandle") == nullptr) {
+			// Watch the buffered amount without a Java observer.
+			webrtc::scoped_refptr<jni::RTCDataChannelCounters> counters(GetHandle<jni::RTCDataChannelCounters>(env, caller, "countersHandle"));
+
+			auto observer = new jni::RTCDataChannelObserver(env, jni::JavaGlobalRef<jobject>(nullptr), counters, drain);
+
+			channel->RegisterObserver(observer);
+
+			SetHandle<jni::RTCDataChannelObserver>(env, caller, "observerHandle", observer);
+		}
+
+		const uint64_t generation = drain->start(env, channel, jni::JavaGlobalRef<jobject>(env, jFuture));
+
+		if (generation == 0) {
+			return;
+		}
+
+		// Capture only the drain, the wrapper may be disposed before the tasks run.
+		signalingThread->PostTask([signalingThread, drain, generation, timeoutMs]() {
+			drain->check();
+
+			signalingThread->PostDelayedTask([drain, generation]() {
+				drain->expire(generation);
+			}, webrtc::TimeDelta::Millis(timeoutMs));
+		});
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_dispose
 (JNIEnv * env, jobject caller)
 {
 	webrtc::DataChannelInterface * channel = GetHandle<webrtc::DataChannelInterface>(env, caller);
 	CHECK_HANDLE(channel);
 
+	jni::RTCDataChannelDrain * drain = GetHandle<jni::RTCDataChannelDrain>(env, caller, "drainHandle");
+
+	if (drain) {
+		// Fail a pending drain, it must not touch the channel once released.
+		SetHandle<std::nullptr_t>(env, caller, "drainHandle", nullptr);
+		drain->cancel(env);
+		drain->Release();
+	}
+
 	webrtc::RefCountReleaseStatus status = channel->Release();
 
 	if (status != webrtc::RefCountReleaseStatus::kDroppedLastRef) {
@@ -156,6 +284,13 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_dispose
 	SetHandle<std::nullptr_t>(env, caller, nullptr);
 
 	channel = nullptr;
+
+	jni::RTCDataChannelCounters * counters = GetHandle<jni::RTCDataChannelCounters>(env, caller, "countersHandle");
+
+	if (counters) {
+		SetHandle<std::nullptr_t>(env, caller, "countersHandle", nullptr);
+		counters->Release();
+	}
 }
 
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_sendDirectBuffer
@@ -171,7 +306,9 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_sendDirectBuffer
 
 		webrtc::CopyOnWriteBuffer data(address, static_cast<size_t>(bufferLength));
 
-		channel->Send(webrtc::DataBuffer(data, static_cast<bool>(isBinary)));
+		if (channel->Send(webrtc::DataBuffer(data, static_cast<bool>(isBinary)))) {
+			CountSentMessage(env, caller, static_cast<uint64_t>(bufferLength));
+		}
 	}
 	else {
 		env->Throw(jni::JavaError(env, "Non-direct buffer provided"));
@@ -192,7 +329,9 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCDataChannel_sendByteArrayBuffer
 	env->ReleaseByteArrayElements(jBufferArray, arrayPtr, JNI_ABORT);
 	
 	try {
-		channel->Send(webrtc::DataBuffer(data, static_cast<bool>(isBinary)));
+		if (channel->Send(webrtc::DataBuffer(data, static_cast<bool>(isBinary)))) {
+			CountSentMessage(env, caller, static_cast<uint64_t>(arrayLength));
+		}
 	}
 	catch (...) {
 		ThrowCxxJavaException(env);
@@ -15,28 +15,46 @@
  */
 
 #include "JNI_RTCPeerConnection.h"
+#include "api/CompiledRTCDataChannelInit.h"
 #include "api/CreateSessionDescriptionObserver.h"
+#include "api/FutureObservers.h"
+#include "api/IceCandidateBatch.h"
+#include "api/NegotiationPipeline.h"
+#include "api/PeerConnectionObserver.h"
 #include "api/SetSessionDescriptionObserver.h"
 #include "api/RTCAnswerOptions.h"
 #include "api/RTCConfiguration.h"
 #include "api/RTCDataChannelInit.h"
 #include "api/RTCIceCandidate.h"
 #include "api/RTCOfferOptions.h"
+#include "api/RTCPeerConnection.h"
 #include "api/RTCSessionDescription.h"
 #include "api/RTCStatsCollectorCallback.h"
+#include "api/RTCStatsSerializedCallback.h"
+#include "api/SdpTemplate.h"
 #include "api/WebRTCUtils.h"
+#include "ShardedPeerConnectionFactory.h"
 #include "JavaArray.h"
 #include "JavaEnums.h"
 #include "JavaFactories.h"
 #include "JavaNullPointerException.h"
+#include "JavaObject.h"
 #include "JavaRef.h"
 #include "JavaRuntimeException.h"
 #include "JavaString.h"
 #include "JavaUtils.h"
 
+#include "api/make_ref_counted.h"
 #include "api/peer_connection_interface.h"
+#include "rtc_base/thread.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getSenders
 (JNIEnv * env, jobject caller)
@@ -122,7 +140,11 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataCha
 
 		auto dataChannel = result.MoveValue();
 
-		return jni::JavaFactories::create(env, dataChannel.release()).release();
+		jni::JavaLocalRef<jobject> jChannel = jni::JavaFactories::create(env, dataChannel.release());
+
+		SetHandle(env, jChannel.get(), "signalingThreadHandle", GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle"));
+
+		return jChannel.release();
 	}
 	catch (...) {
 		ThrowCxxJavaException(env);
@@ -130,6 +152,152 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataCha
 	}
 }
 
+static jobjectArray CreateDataChannels(JNIEnv * env, jobject caller, webrtc::PeerConnectionInterface * pc, jobjectArray jLabels,
+	const std::vector<const webrtc::DataChannelInit *> & inits)
+{
+	const jsize size = env->GetArrayLength(jLabels);
+
+	std::vector<std::string> labels;
+	labels.reserve(size);
+
+	for (jsize i = 0; i < size; i++) {
+		jni::JavaLocalRef<jstring> jLabel(env, static_cast<jstring>(env->GetObjectArrayElement(jLabels, i)));
+
+		if (jLabel.get() == nullptr) {
+			env->Throw(jni::JavaNullPointerException(env, "Label must not be null"));
+			return nullptr;
+		}
+
+		labels.push_back(jni::JavaString::toNative(env, jLabel));
+	}
+
+	std::vector<webrtc::scoped_refptr<webrtc::DataChannelInterface>> channels;
+	channels.reserve(size);
+
+	webrtc::RTCError error;
+
+	auto create = [&]() {
+		for (jsize i = 0; i < size; i++) {
+			// Proxy calls made on the signaling thread are invoked directly.
+			auto result = pc->CreateDataChannelOrError(labels[i], inits.size() == 1 ? inits[0] : inits[i]);
+
+			if (!result.ok()) {
+				error = result.MoveError();
+
+				for (const auto & channel : channels) {
+					channel->Close();
+				}
+				return;
+			}
+
+			channels.push_back(result.MoveValue());
+		}
+	};
+
+	webrtc::Thread * signalingThread = GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle");
+
+	if (signalingThread == nullptr || signalingThread->IsCurrent()) {
+		create();
+	}
+	else {
+		// One task for all channels instead of one blocking proxy call each.
+		signalingThread->BlockingCall(create);
+	}
+
+	if (!error.ok()) {
+		env->Throw(jni::JavaRuntimeException(env, "Create DataChannel '%s' failed: %s %s",
+			labels[channels.size()].c_str(), ToString(error.type()), error.message()));
+
+		return nullptr;
+	}
+
+	jni::JavaLocalRef<jobjectArray> array = jni::JavaFactories::createArray<webrtc::DataChannelInterface>(env, size);
+
+	for (jsize i = 0; i < size; i++) {
+		jni::JavaLocalRef<jobject> jChannel = jni::JavaFactories::create(env, channels[i].release());
+
+		SetHandle(env, jChannel.get(), "signalingThreadHandle", signalingThread);
+
+		env->SetObjectArrayElement(array.get(), i, jChannel.get());
+	}
+
+	return array.release();
+}
+
+JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataChannelsInit
+(JNIEnv * env, jobject caller, jobjectArray jLabels, jobjectArray jDicts)
+{
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLEV(pc, nullptr);
+
+	try {
+		const jsize size = env->GetArrayLength(jDicts);
+
+		std::vector<webrtc::DataChannelInit> dicts;
+		dicts.reserve(size);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jobject> jDict(env, env->GetObjectArrayElement(jDicts, i));
+
+			if (jDict.get() == nullptr) {
+				env->Throw(jni::JavaNullPointerException(env, "RTCDataChannelInit must not be null"));
+				return nullptr;
+			}
+
+			dicts.push_back(jni::RTCDataChannelInit::toNative(env, jDict));
+		}
+
+		std::vector<const webrtc::DataChannelInit *> inits;
+		inits.reserve(size);
+
+		for (const auto & dict : dicts) {
+			inits.push_back(&dict);
+		}
+
+		return CreateDataChannels(env, caller, pc, jLabels, inits);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createDataChannelsCompiled
+(JNIEnv * env, jobject caller, jobjectArray jLabels, jobjectArray jDicts)
+{
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLEV(pc, nullptr);
+
+	try {
+		const jsize size = env->GetArrayLength(jDicts);
+
+		std::vector<const webrtc::DataChannelInit *> inits;
+		inits.reserve(size);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jobject> jDict(env, env->GetObjectArrayElement(jDicts, i));
+
+			if (jDict.get() == nullptr) {
+				env->Throw(jni::JavaNullPointerException(env, "CompiledRTCDataChannelInit must not be null"));
+				return nullptr;
+			}
+
+			auto compiled = static_cast<jni::CompiledRTCDataChannelInit *>(GetHandle<webrtc::RefCountInterface>(env, jDict.get()));
+			CHECK_HANDLEV(compiled, nullptr);
+
+			inits.push_back(&compiled->get());
+		}
+
+		return CreateDataChannels(env, caller, pc, jLabels, inits);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createOffer
 (JNIEnv * env, jobject caller, jobject jOptions, jobject jObserver)
 {
@@ -147,7 +315,9 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createOffer
 
 	try {
 		auto options = jni::RTCOfferOptions::toNative(env, jni::JavaLocalRef<jobject>(env, jOptions));
-		auto observer = new webrtc::RefCountedObject<jni::CreateSessionDescriptionObserver>(env, jni::JavaGlobalRef<jobject>(env, jObserver));
+		bool iceLite = jni::RTCPeerConnection::isIceLite(env, caller);
+		bool sdpTemplate = jni::RTCPeerConnection::useSdpTemplate(env, caller);
+		auto observer = new webrtc::RefCountedObject<jni::CreateSessionDescriptionObserver>(env, jni::JavaGlobalRef<jobject>(env, jObserver), iceLite, sdpTemplate);
 
 		pc->CreateOffer(observer, options);
 	}
@@ -173,7 +343,9 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAnswer
 
 	try {
 		auto options = jni::RTCAnswerOptions::toNative(env, jni::JavaLocalRef<jobject>(env, jOptions));
-		auto observer = new webrtc::RefCountedObject<jni::CreateSessionDescriptionObserver>(env, jni::JavaGlobalRef<jobject>(env, jObserver));
+		bool iceLite = jni::RTCPeerConnection::isIceLite(env, caller);
+		bool sdpTemplate = jni::RTCPeerConnection::useSdpTemplate(env, caller);
+		auto observer = new webrtc::RefCountedObject<jni::CreateSessionDescriptionObserver>(env, jni::JavaGlobalRef<jobject>(env, jObserver), iceLite, sdpTemplate);
 
 		pc->CreateAnswer(observer, options);
 	}
@@ -182,6 +354,77 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAnswer
 	}
 }
 
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAndSetLocalOffer
+(JNIEnv * env, jobject caller, jobject jOptions, jobject jCallback)
+{
+	if (jOptions == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCOfferOptions must not be null"));
+		return;
+	}
+	if (jCallback == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "NegotiationCallback must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		auto options = jni::RTCOfferOptions::toNative(env, jni::JavaLocalRef<jobject>(env, jOptions));
+		bool iceLite = jni::RTCPeerConnection::isIceLite(env, caller);
+		bool sdpTemplate = jni::RTCPeerConnection::useSdpTemplate(env, caller);
+		auto pipeline = webrtc::make_ref_counted<jni::NegotiationPipeline>(env, webrtc::scoped_refptr<webrtc::PeerConnectionInterface>(pc),
+			options, jni::JavaGlobalRef<jobject>(env, jCallback), iceLite, sdpTemplate);
+
+		pipeline->createOffer();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_answerRemoteOffer
+(JNIEnv * env, jobject caller, jstring jSdp, jobject jOptions, jobject jCallback)
+{
+	if (jSdp == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "Offer SDP must not be null"));
+		return;
+	}
+	if (jOptions == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCAnswerOptions must not be null"));
+		return;
+	}
+	if (jCallback == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "NegotiationCallback must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		std::string sdp = jni::JavaString::toNative(env, jni::JavaLocalRef<jstring>(env, jSdp));
+		bool sdpTemplate = jni::RTCPeerConnection::useSdpTemplate(env, caller);
+		webrtc::SdpParseError error;
+
+		auto offer = jni::SdpTemplate::deserialize(webrtc::SdpType::kOffer, sdp, &error, sdpTemplate);
+
+		if (offer == nullptr) {
+			throw jni::Exception("Create session description failed: %s [%s]", error.description.c_str(), error.line.c_str());
+		}
+
+		auto options = jni::RTCAnswerOptions::toNative(env, jni::JavaLocalRef<jobject>(env, jOptions));
+		bool iceLite = jni::RTCPeerConnection::isIceLite(env, caller);
+		auto pipeline = webrtc::make_ref_counted<jni::NegotiationPipeline>(env, webrtc::scoped_refptr<webrtc::PeerConnectionInterface>(pc),
+			options, jni::JavaGlobalRef<jobject>(env, jCallback), iceLite, sdpTemplate);
+
+		pipeline->answerOffer(std::move(offer));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
 JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getCurrentLocalDescription
 (JNIEnv * env, jobject caller)
 {
@@ -192,7 +435,7 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getCurrentLoc
 		return nullptr;
 	}
 
-	return jni::RTCSessionDescription::toJava(env, pc->current_local_description()).release();
+	return jni::RTCSessionDescription::toJava(env, pc->current_local_description(), jni::RTCPeerConnection::useSdpTemplate(env, caller)).release();
 }
 
 JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getLocalDescription
@@ -205,7 +448,7 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getLocalDescr
 		return nullptr;
 	}
 
-	return jni::RTCSessionDescription::toJava(env, pc->local_description()).release();
+	return jni::RTCSessionDescription::toJava(env, pc->local_description(), jni::RTCPeerConnection::useSdpTemplate(env, caller)).release();
 }
 
 JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getPendingLocalDescription
@@ -218,7 +461,7 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getPendingLoc
 		return nullptr;
 	}
 
-	return jni::RTCSessionDescription::toJava(env, pc->pending_local_description()).release();
+	return jni::RTCSessionDescription::toJava(env, pc->pending_local_description(), jni::RTCPeerConnection::useSdpTemplate(env, caller)).release();
 }
 
 JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getCurrentRemoteDescription
@@ -231,7 +474,7 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getCurrentRem
 		return nullptr;
 	}
 
-	return jni::RTCSessionDescription::toJava(env, pc->current_remote_description()).release();
+	return jni::RTCSessionDescription::toJava(env, pc->current_remote_description(), jni::RTCPeerConnection::useSdpTemplate(env, caller)).release();
 }
 
 JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getRemoteDescription
@@ -244,7 +487,7 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getRemoteDesc
 		return nullptr;
 	}
 
-	return jni::RTCSessionDescription::toJava(env, pc->remote_description()).release();
+	return jni::RTCSessionDescription::toJava(env, pc->remote_description(), jni::RTCPeerConnection::useSdpTemplate(env, caller)).release();
 }
 
 JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getPendingRemoteDescription
@@ -257,7 +500,7 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getPendingRem
 		return nullptr;
 	}
 
-	return jni::RTCSessionDescription::toJava(env, pc->pending_remote_description()).release();
+	return jni::RTCSessionDescription::toJava(env, pc->pending_remote_description(), jni::RTCPeerConnection::useSdpTemplate(env, caller)).release();
 }
 
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setLocalDescription
@@ -276,7 +519,7 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setLocalDescript
 	CHECK_HANDLE(pc);
 
 	try {
-		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jSessionDesc));
+		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jSessionDesc), jni::RTCPeerConnection::useSdpTemplate(env, caller));
 		auto observer = new webrtc::RefCountedObject<jni::SetSessionDescriptionObserver>(env, jni::JavaGlobalRef<jobject>(env, jobserver));
 
 		pc->SetLocalDescription(observer, desc.release());
@@ -302,7 +545,7 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setRemoteDescrip
 	CHECK_HANDLE(pc);
 
 	try {
-		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jSessionDesc));
+		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jSessionDesc), jni::RTCPeerConnection::useSdpTemplate(env, caller));
 		auto observer = new webrtc::RefCountedObject<jni::SetSessionDescriptionObserver>(env, jni::JavaGlobalRef<jobject>(env, jobserver));
 
 		pc->SetRemoteDescription(observer, desc.release());
@@ -333,6 +576,104 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_addIceCandidate
 	}
 }
 
+static void ApplyIceCandidateBatch(JNIEnv * env, jobject caller, webrtc::PeerConnectionInterface * pc, std::shared_ptr<jni::IceCandidateBatch> batch)
+{
+	webrtc::Thread * signalingThread = GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle");
+
+	if (signalingThread == nullptr || signalingThread->IsCurrent()) {
+		batch->apply(pc);
+		return;
+	}
+
+	// One task for all candidates instead of one blocking proxy call each.
+	signalingThread->PostTask([pc = webrtc::scoped_refptr<webrtc::PeerConnectionInterface>(pc), batch]() {
+		batch->apply(pc.get());
+	});
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_addIceCandidatesFuture
+(JNIEnv * env, jobject caller, jobjectArray jCandidates, jobject jFuture)
+{
+	if (jCandidates == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCIceCandidate array must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		const auto javaClass = jni::JavaClasses::get<jni::RTCIceCandidate::JavaRTCIceCandidateClass>(env);
+		const jsize size = env->GetArrayLength(jCandidates);
+
+		auto batch = std::make_shared<jni::IceCandidateBatch>(env, jni::JavaGlobalRef<jobject>(env, jFuture), size);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jobject> jCandidate(env, env->GetObjectArrayElement(jCandidates, i));
+
+			if (jCandidate.get() == nullptr) {
+				batch->reject(i, "RTCIceCandidate is null");
+				continue;
+			}
+
+			jni::JavaObject obj(env, jCandidate);
+
+			batch->parse(i,
+				jni::JavaString::toNative(env, obj.getString(javaClass->sdpMid)),
+				obj.getInt(javaClass->sdpMLineIndex),
+				jni::JavaString::toNative(env, obj.getString(javaClass->sdp)));
+		}
+
+		ApplyIceCandidateBatch(env, caller, pc, batch);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_addIceCandidatesRaw
+(JNIEnv * env, jobject caller, jobjectArray jSdpMids, jintArray jSdpMLineIndices, jobjectArray jSdps, jobject jFuture)
+{
+	if (jSdpMids == nullptr || jSdpMLineIndices == nullptr || jSdps == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "ICE candidate arrays must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	const jsize size = env->GetArrayLength(jSdps);
+
+	if (env->GetArrayLength(jSdpMids) != size || env->GetArrayLength(jSdpMLineIndices) != size) {
+		env->Throw(jni::JavaRuntimeException(env, "ICE candidate arrays differ in length"));
+		return;
+	}
+
+	try {
+		std::vector<jint> sdpMLineIndices(size);
+		env->GetIntArrayRegion(jSdpMLineIndices, 0, size, sdpMLineIndices.data());
+
+		auto batch = std::make_shared<jni::IceCandidateBatch>(env, jni::JavaGlobalRef<jobject>(env, jFuture), size);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jstring> jSdp(env, static_cast<jstring>(env->GetObjectArrayElement(jSdps, i)));
+			jni::JavaLocalRef<jstring> jSdpMid(env, static_cast<jstring>(env->GetObjectArrayElement(jSdpMids, i)));
+
+			if (jSdp.get() == nullptr) {
+				batch->reject(i, "ICE candidate SDP is null");
+				continue;
+			}
+
+			batch->parse(i, jni::JavaString::toNative(env, jSdpMid), sdpMLineIndices[i], jni::JavaString::toNative(env, jSdp));
+		}
+
+		ApplyIceCandidateBatch(env, caller, pc, batch);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_removeIceCandidates
 (JNIEnv * env, jobject caller, jobject jCandidates)
 {
@@ -393,16 +734,26 @@ JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getConnection
 	return jni::JavaEnums::toJava(env, pc->peer_connection_state()).release();
 }
 
-JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getConfiguration
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_queryConfiguration
 (JNIEnv * env, jobject caller)
 {
 	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
 	CHECK_HANDLEV(pc, nullptr);
 
-	return jni::RTCConfiguration::toJava(env, pc->GetConfiguration()).release();
+	const jni::PeerConnectionOptions * options = jni::RTCPeerConnection::getOptions(env, caller);
+
+	try {
+		return jni::RTCConfiguration::toJava(env, pc->GetConfiguration(),
+			options ? *options : jni::PeerConnectionOptions()).release();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
 }
 
-JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setConfiguration
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_applyConfiguration
 (JNIEnv * env, jobject caller, jobject jConfig)
 {
 	if (jConfig == nullptr) {
@@ -413,9 +764,27 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setConfiguration
 	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
 	CHECK_HANDLE(pc);
 
-	auto config = jni::RTCConfiguration::toNative(env, jni::JavaLocalRef<jobject>(env, jConfig));
+	jni::PeerConnectionConfiguration config;
 
-	webrtc::RTCError error = pc->SetConfiguration(config);
+	try {
+		config = jni::RTCConfiguration::toPeerConnectionConfiguration(env, jni::JavaLocalRef<jobject>(env, jConfig));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+		return;
+	}
+
+	// These options are applied by the port allocator and the observer created
+	// with the peer connection, they cannot be changed afterwards.
+	const jni::PeerConnectionOptions * options = jni::RTCPeerConnection::getOptions(env, caller);
+
+	if (options != nullptr && config.options != *options) {
+		env->Throw(jni::JavaRuntimeException(env,
+			"iceLite, iceCandidateBatchWindow, sdpTemplate, sharedUdpPort and the network filter can only be set when the RTCPeerConnection is created"));
+		return;
+	}
+
+	webrtc::RTCError error = pc->SetConfiguration(config.configuration);
 
 	if (!error.ok()) {
 		env->Throw(jni::JavaRuntimeException(env, jni::RTCErrorToString(error).c_str()));
@@ -438,6 +807,130 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getStats__Ldev_k
 	pc->GetStats(callback);
 }
 
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getStatsSerialized
+(JNIEnv * env, jobject caller, jobject jFormat, jobject jcallback)
+{
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	if (jFormat == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCStatsFormat is null"));
+		return;
+	}
+	if (jcallback == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCStatsSerializedCallback is null"));
+		return;
+	}
+
+	auto format = jni::JavaEnums::toNative<jni::RTCStatsSerializer::RTCStatsFormat>(env, jFormat);
+	auto callback = new webrtc::RefCountedObject<jni::RTCStatsSerializedCallback>(env, jni::JavaGlobalRef<jobject>(env, jcallback), format);
+
+	pc->GetStats(callback);
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createOfferFuture
+(JNIEnv * env, jobject caller, jobject jOptions, jobject jFuture)
+{
+	if (jOptions == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCOfferOptions must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		auto options = jni::RTCOfferOptions::toNative(env, jni::JavaLocalRef<jobject>(env, jOptions));
+		bool iceLite = jni::RTCPeerConnection::isIceLite(env, caller);
+		bool sdpTemplate = jni::RTCPeerConnection::useSdpTemplate(env, caller);
+		auto observer = new webrtc::RefCountedObject<jni::CreateSessionDescriptionFuture>(env, jni::JavaGlobalRef<jobject>(env, jFuture), iceLite, sdpTemplate);
+
+		pc->CreateOffer(observer, options);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_createAnswerFuture
+(JNIEnv * env, jobject caller, jobject jOptions, jobject jFuture)
+{
+	if (jOptions == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCAnswerOptions must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		auto options = jni::RTCAnswerOptions::toNative(env, jni::JavaLocalRef<jobject>(env, jOptions));
+		bool iceLite = jni::RTCPeerConnection::isIceLite(env, caller);
+		bool sdpTemplate = jni::RTCPeerConnection::useSdpTemplate(env, caller);
+		auto observer = new webrtc::RefCountedObject<jni::CreateSessionDescriptionFuture>(env, jni::JavaGlobalRef<jobject>(env, jFuture), iceLite, sdpTemplate);
+
+		pc->CreateAnswer(observer, options);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setLocalDescriptionFuture
+(JNIEnv * env, jobject caller, jobject jSessionDesc, jobject jFuture)
+{
+	if (jSessionDesc == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCSessionDescription must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jSessionDesc), jni::RTCPeerConnection::useSdpTemplate(env, caller));
+		auto observer = webrtc::make_ref_counted<jni::SetLocalDescriptionFuture>(env, jni::JavaGlobalRef<jobject>(env, jFuture));
+
+		pc->SetLocalDescription(std::move(desc), observer);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_setRemoteDescriptionFuture
+(JNIEnv * env, jobject caller, jobject jSessionDesc, jobject jFuture)
+{
+	if (jSessionDesc == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCSessionDescription must not be null"));
+		return;
+	}
+
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jSessionDesc), jni::RTCPeerConnection::useSdpTemplate(env, caller));
+		auto observer = webrtc::make_ref_counted<jni::SetRemoteDescriptionFuture>(env, jni::JavaGlobalRef<jobject>(env, jFuture));
+
+		pc->SetRemoteDescription(std::move(desc), observer);
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_getStatsFuture
+(JNIEnv * env, jobject caller, jobject jFuture)
+{
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	auto callback = new webrtc::RefCountedObject<jni::RTCStatsFuture>(env, jni::JavaGlobalRef<jobject>(env, jFuture));
+
+	pc->GetStats(callback);
+}
+
 JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_restartIce
 (JNIEnv * env, jobject caller)
 {
@@ -447,23 +940,197 @@ JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_restartIce
 	pc->RestartIce();
 }
 
-JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_close
+/*
+ * A peer connection whose handles have been taken from its Java object, so
+ * that it can be closed on another thread.
+ */
+struct DetachedPeerConnection
+{
+	webrtc::scoped_refptr<webrtc::PeerConnectionInterface> pc;
+	jni::PeerConnectionObserver * observer;
+	jni::PeerConnectionShardLoad * load;
+	jni::PeerConnectionOptions * options;
+};
+
+/*
+ * Completes the close future once all batches of peer connections are closed.
+ */
+struct CloseCompletion
+{
+	CloseCompletion(JNIEnv * env, const jni::JavaGlobalRef<jobject> & future) :
+		future(env, future)
+	{
+	}
+
+	jni::JavaFuture future;
+	std::atomic<std::size_t> pending { 0 };
+};
+
+// Closed in one signaling thread task. Keeps the signaling thread responsive
+// to other peer connections while closing many at once.
+static const std::size_t kCloseBatchSize = 64;
+
+static DetachedPeerConnection DetachPeerConnection(JNIEnv * env, jobject jPeerConnection, webrtc::PeerConnectionInterface * pc)
+{
+	DetachedPeerConnection detached {
+		webrtc::scoped_refptr<webrtc::PeerConnectionInterface>(pc),
+		GetHandle<jni::PeerConnectionObserver>(env, jPeerConnection, "observerHandle"),
+		GetHandle<jni::PeerConnectionShardLoad>(env, jPeerConnection, "shardLoadHandle"),
+		jni::RTCPeerConnection::detachOptions(env, jPeerConnection)
+	};
+
+	SetHandle<std::nullptr_t>(env, jPeerConnection, nullptr);
+	SetHandle<std::nullptr_t>(env, jPeerConnection, "observerHandle", nullptr);
+	SetHandle<std::nullptr_t>(env, jPeerConnection, "shardLoadHandle", nullptr);
+
+	return detached;
+}
+
+/*
+ * Runs on the signaling thread, where the observer's batched candidates are
+ * flushed and its pending flush task is bound.
+ */
+static void ClosePeerConnection(DetachedPeerConnection & detached)
+{
+	detached.pc->Close();
+
+	if (detached.observer) {
+		detached.observer->close();
+
+		delete detached.observer;
+	}
+
+	if (detached.load) {
+		detached.load->decrement();
+		detached.load->Release();
+	}
+
+	// Released after Close(), so that no call still running on the signaling
+	// thread reads freed options.
+	delete detached.options;
+}
+
+static void CloseBatch(std::vector<DetachedPeerConnection> batch, std::shared_ptr<CloseCompletion> completion)
+{
+	for (auto & detached : batch) {
+		ClosePeerConnection(detached);
+	}
+
+	batch.clear();
+
+	if (completion->pending.fetch_sub(1) == 1) {
+		completion->future.complete(AttachCurrentThread(), nullptr);
+	}
+}
+
+static void ClosePeerConnections(JNIEnv * env, std::map<webrtc::Thread *, std::vector<DetachedPeerConnection>> connections,
+	const jni::JavaGlobalRef<jobject> & jFuture)
+{
+	auto completion = std::make_shared<CloseCompletion>(env, jFuture);
+
+	std::vector<std::pair<webrtc::Thread *, std::vector<DetachedPeerConnection>>> batches;
+
+	for (auto & [thread, detached] : connections) {
+		for (std::size_t offset = 0; offset < detached.size(); offset += kCloseBatchSize) {
+			auto begin = detached.begin() + offset;
+			auto end = detached.begin() + std::min(offset + kCloseBatchSize, detached.size());
+
+			batches.emplace_back(thread, std::vector<DetachedPeerConnection>(std::make_move_iterator(begin), std::make_move_iterator(end)));
+		}
+	}
+
+	if (batches.empty()) {
+		completion->future.complete(env, nullptr);
+		return;
+	}
+
+	completion->pending = batches.size();
+
+	for (auto & [thread, batch] : batches) {
+		if (thread == nullptr || thread->IsCurrent()) {
+			CloseBatch(std::move(batch), completion);
+			continue;
+		}
+
+		// Batches on different shards are closed in parallel.
+		thread->PostTask([batch = std::move(batch), completion]() mutable {
+			CloseBatch(std::move(batch), completion);
+		});
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_closeConnection
 (JNIEnv * env, jobject caller)
 {
 	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
 	CHECK_HANDLE(pc);
 
 	try {
-		pc->Close();
+		webrtc::Thread * signalingThread = GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle");
 
-		SetHandle<std::nullptr_t>(env, caller, nullptr);
+		DetachedPeerConnection detached = DetachPeerConnection(env, caller, pc);
 
-		auto observer = GetHandle<webrtc::PeerConnectionObserver>(env, caller, "observerHandle");
+		if (signalingThread == nullptr || signalingThread->IsCurrent()) {
+			ClosePeerConnection(detached);
+		}
+		else {
+			signalingThread->BlockingCall([&detached]() {
+				ClosePeerConnection(detached);
+			});
+		}
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
 
-		if (observer) {
-		    SetHandle<std::nullptr_t>(env, caller, "observerHandle", nullptr);
-			delete observer;
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_closeFuture
+(JNIEnv * env, jobject caller, jobject jFuture)
+{
+	webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, caller);
+	CHECK_HANDLE(pc);
+
+	try {
+		webrtc::Thread * signalingThread = GetHandle<webrtc::Thread>(env, caller, "signalingThreadHandle");
+
+		std::map<webrtc::Thread *, std::vector<DetachedPeerConnection>> connections;
+		connections[signalingThread].push_back(DetachPeerConnection(env, caller, pc));
+
+		ClosePeerConnections(env, std::move(connections), jni::JavaGlobalRef<jobject>(env, jFuture));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+}
+
+JNIEXPORT void JNICALL Java_dev_kastle_webrtc_RTCPeerConnection_closeAll
+(JNIEnv * env, jclass caller, jobjectArray jPeerConnections, jobject jFuture)
+{
+	try {
+		std::map<webrtc::Thread *, std::vector<DetachedPeerConnection>> connections;
+
+		const jsize size = env->GetArrayLength(jPeerConnections);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jobject> jPeerConnection(env, env->GetObjectArrayElement(jPeerConnections, i));
+
+			if (jPeerConnection.get() == nullptr) {
+				continue;
+			}
+
+			webrtc::PeerConnectionInterface * pc = GetHandle<webrtc::PeerConnectionInterface>(env, jPeerConnection.get());
+
+			// Already closed.
+			if (pc == nullptr) {
+				continue;
+			}
+
+			webrtc::Thread * signalingThread = GetHandle<webrtc::Thread>(env, jPeerConnection.get(), "signalingThreadHandle");
+
+			connections[signalingThread].push_back(DetachPeerConnection(env, jPeerConnection.get(), pc));
 		}
+
+		ClosePeerConnections(env, std::move(connections), jni::JavaGlobalRef<jobject>(env, jFuture));
 	}
 	catch (...) {
 		ThrowCxxJavaException(env);
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JNI_SdpCodec.h"
+#include "api/RTCIceCandidate.h"
+#include "api/RTCSessionDescription.h"
+#include "api/SdpCodec.h"
+#include "JavaClasses.h"
+#include "JavaNullPointerException.h"
+#include "JavaRef.h"
+#include "JavaUtils.h"
+
+#include <vector>
+
+static jbyteArray ToJavaByteArray(JNIEnv * env, const std::vector<uint8_t> & data)
+{
+	const jsize length = static_cast<jsize>(data.size());
+
+	jbyteArray array = env->NewByteArray(length);
+	env->SetByteArrayRegion(array, 0, length, reinterpret_cast<const jbyte *>(data.data()));
+
+	return array;
+}
+
+static std::vector<uint8_t> ToNativeByteArray(JNIEnv * env, jbyteArray array)
+{
+	std::vector<uint8_t> data(env->GetArrayLength(array));
+
+	env->GetByteArrayRegion(array, 0, static_cast<jsize>(data.size()), reinterpret_cast<jbyte *>(data.data()));
+
+	return data;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_dev_kastle_webrtc_SdpCodec_encodeDescription
+(JNIEnv * env, jclass caller, jobject jDescription)
+{
+	if (jDescription == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCSessionDescription must not be null"));
+		return nullptr;
+	}
+
+	try {
+		auto desc = jni::RTCSessionDescription::toNative(env, jni::JavaLocalRef<jobject>(env, jDescription));
+
+		return ToJavaByteArray(env, jni::SdpCodec::encodeDescription(*desc));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
+JNIEXPORT jobject JNICALL Java_dev_kastle_webrtc_SdpCodec_decodeDescription
+(JNIEnv * env, jclass caller, jbyteArray jData)
+{
+	if (jData == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "Encoded description must not be null"));
+		return nullptr;
+	}
+
+	try {
+		std::vector<uint8_t> data = ToNativeByteArray(env, jData);
+
+		auto desc = jni::SdpCodec::decodeDescription(data.data(), data.size());
+
+		return jni::RTCSessionDescription::toJava(env, desc.get()).release();
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_dev_kastle_webrtc_SdpCodec_encodeCandidates
+(JNIEnv * env, jclass caller, jobjectArray jCandidates)
+{
+	if (jCandidates == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "RTCIceCandidate array must not be null"));
+		return nullptr;
+	}
+
+	try {
+		const jsize size = env->GetArrayLength(jCandidates);
+
+		std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> candidates;
+		candidates.reserve(size);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jobject> jCandidate(env, env->GetObjectArrayElement(jCandidates, i));
+
+			if (jCandidate.get() == nullptr) {
+				env->Throw(jni::JavaNullPointerException(env, "RTCIceCandidate must not be null"));
+				return nullptr;
+			}
+
+			candidates.push_back(jni::RTCIceCandidate::toNative(env, jCandidate));
+		}
+
+		return ToJavaByteArray(env, jni::SdpCodec::encodeCandidates(candidates));
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_dev_kastle_webrtc_SdpCodec_decodeCandidates
+(JNIEnv * env, jclass caller, jbyteArray jData)
+{
+	if (jData == nullptr) {
+		env->Throw(jni::JavaNullPointerException(env, "Encoded candidates must not be null"));
+		return nullptr;
+	}
+
+	try {
+		std::vector<uint8_t> data = ToNativeByteArray(env, jData);
+
+		auto candidates = jni::SdpCodec::decodeCandidates(data.data(), data.size());
+
+		const auto javaClass = jni::JavaClasses::get<jni::RTCIceCandidate::JavaRTCIceCandidateClass>(env);
+		const jsize size = static_cast<jsize>(candidates.size());
+
+		jobjectArray array = env->NewObjectArray(size, javaClass->cls, nullptr);
+
+		for (jsize i = 0; i < size; i++) {
+			jni::JavaLocalRef<jobject> jCandidate = jni::RTCIceCandidate::toJava(env, candidates[i].get());
+
+			env->SetObjectArrayElement(array, i, jCandidate);
+		}
+
+		return array;
+	}
+	catch (...) {
+		ThrowCxxJavaException(env);
+	}
+
+	return nullptr;
+}
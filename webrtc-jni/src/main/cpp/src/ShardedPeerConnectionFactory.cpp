@@ -0,0 +1,493 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShardedPeerConnectionFactory.h"
+#include "rtc/BatchingSocketServer.h"
+#include "rtc/SharedUdpPort.h"
+#include "Exception.h"
+
+#include "api/environment/environment_factory.h"
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/socket_address.h"
+
+#include <limits>
+#include <string>
+
+namespace jni
+{
+	/*
+	 * Callbacks of the certificates being generated by a shard, by
+	 * generation number.
+	 */
+	struct PendingCertificates
+	{
+		std::mutex mutex;
+		std::map<uint64_t, CertificateCallback> callbacks;
+		uint64_t sequence = 0;
+
+		/*
+		 * Removes the callback of a generation, or returns an empty one if the
+		 * generation has already been failed by dispose.
+		 */
+		CertificateCallback take(uint64_t id)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			auto it = callbacks.find(id);
+
+			if (it == callbacks.end()) {
+				return nullptr;
+			}
+
+			CertificateCallback callback = std::move(it->second);
+			callbacks.erase(it);
+
+			return callback;
+		}
+	};
+
+	static std::unique_ptr<webrtc::Thread> StartThread(std::unique_ptr<webrtc::Thread> thread, const char * name, std::size_t index, bool indexed)
+	{
+		std::string threadName(name);
+
+		if (indexed) {
+			threadName += "_" + std::to_string(index);
+		}
+
+		thread->SetName(threadName, nullptr);
+
+		if (!thread->Start()) {
+			throw Exception("Start %s failed", threadName.c_str());
+		}
+
+		return thread;
+	}
+
+	/*
+	 * Checks that a shared UDP port can be bound before any ICE port is
+	 * gathered on it. Uses its own socket server, since the network thread
+	 * must not be blocked while the socket factory is locked.
+	 */
+	static bool IsUdpPortAvailable(uint16_t port)
+	{
+		webrtc::PhysicalSocketServer socketServer;
+
+		std::unique_ptr<webrtc::Socket> socket(socketServer.CreateSocket(AF_INET, SOCK_DGRAM));
+
+		return socket && socket->Bind(webrtc::SocketAddress("0.0.0.0", port)) == 0;
+	}
+
+	static std::unique_ptr<webrtc::Thread> CreateNetworkThread(const PeerConnectionFactoryOptions & options, BatchingSocketServer ** batching)
+	{
+#if defined(WEBRTC_LINUX)
+		// UDP offload is implemented by the batching sockets.
+		if (options.socketServer == SocketServerType::kBatching || options.udpOffload) {
+			auto socketServer = std::make_unique<BatchingSocketServer>(options.udpOffload);
+			*batching = socketServer.get();
+
+			return std::make_unique<webrtc::Thread>(std::move(socketServer));
+		}
+#endif
+		// Other platforms fall back to the default socket server.
+		return webrtc::Thread::CreateWithSocketServer();
+	}
+
+	PeerConnectionFactoryShard::PeerConnectionFactoryShard(const PeerConnectionFactoryOptions & options, std::size_t index) :
+		environment(webrtc::CreateEnvironment()),
+		pendingCertificates(std::make_shared<PendingCertificates>()),
+		load(webrtc::make_ref_counted<PeerConnectionShardLoad>())
+	{
+		const bool indexed = options.shards > 1;
+
+		webrtc::PeerConnectionFactoryDependencies dependencies;
+
+		if (options.applicationSignalingThread) {
+			unwrapApplicationThread = webrtc::Thread::Current() == nullptr;
+			applicationThread = webrtc::ThreadManager::Instance()->WrapCurrentThread();
+
+			networkThread = StartThread(CreateNetworkThread(options, &batchingSocketServer), "webrtc_jni_network_thread", index, indexed);
+
+			if (!options.singleThread) {
+				workerThread = StartThread(webrtc::Thread::Create(), "webrtc_jni_worker_thread", index, indexed);
+			}
+
+			dependencies.network_thread = networkThread.get();
+			dependencies.worker_thread = workerThread ? workerThread.get() : networkThread.get();
+			dependencies.signaling_thread = applicationThread;
+		}
+		else if (options.singleThread) {
+			// Only the network thread is owned, the other roles share it.
+			networkThread = StartThread(CreateNetworkThread(options, &batchingSocketServer), "webrtc_jni_thread", index, indexed);
+
+			dependencies.network_thread = networkThread.get();
+			dependencies.worker_thread = networkThread.get();
+			dependencies.signaling_thread = networkThread.get();
+		}
+		else {
+			networkThread = StartThread(CreateNetworkThread(options, &batchingSocketServer), "webrtc_jni_network_thread", index, indexed);
+			signalingThread = StartThread(webrtc::Thread::Create(), "webrtc_jni_signaling_thread", index, indexed);
+			workerThread = StartThread(webrtc::Thread::Create(), "webrtc_jni_worker_thread", index, indexed);
+
+			dependencies.network_thread = networkThread.get();
+			dependencies.worker_thread = workerThread.get();
+			dependencies.signaling_thread = signalingThread.get();
+		}
+
+		signalingRole = dependencies.signaling_thread;
+
+		certificateGenerator = std::make_unique<webrtc::RTCCertificateGenerator>(signalingRole, dependencies.worker_thread);
+
+		networkThread->BlockingCall([this]() {
+			webrtc::SocketServer * socketServer = networkThread->socketserver();
+
+			socketFactory = std::make_unique<webrtc::BasicPacketSocketFactory>(socketServer);
+			networkManager = std::make_unique<webrtc::BasicNetworkManager>(environment, socketServer);
+
+			// Keep the networks enumerated while no connection is gathering.
+			networkManager->StartUpdating();
+		});
+
+		factory = webrtc::CreateModularPeerConnectionFactory(std::move(dependencies));
+
+		if (factory == nullptr) {
+			throw Exception("Create PeerConnectionFactory failed");
+		}
+	}
+
+	PeerConnectionFactoryShard::~PeerConnectionFactoryShard()
+	{
+		dispose();
+	}
+
+	webrtc::PeerConnectionFactoryInterface * PeerConnectionFactoryShard::getFactory() const
+	{
+		return factory.get();
+	}
+
+	PeerConnectionShardLoad * PeerConnectionFactoryShard::getLoad() const
+	{
+		return load.get();
+	}
+
+	webrtc::Thread * PeerConnectionFactoryShard::getSignalingThread() const
+	{
+		return signalingRole;
+	}
+
+	void PeerConnectionFactoryShard::generateCertificate(const webrtc::KeyParams & params, const std::optional<uint64_t> & expiresMs,
+		CertificateCallback callback)
+	{
+		std::lock_guard<std::mutex> lock(pendingCertificates->mutex);
+
+		if (!certificateGenerator) {
+			throw Exception("Factory has been disposed");
+		}
+
+		const uint64_t id = ++pendingCertificates->sequence;
+
+		pendingCertificates->callbacks.emplace(id, std::move(callback));
+
+		certificateGenerator->GenerateCertificateAsync(params, expiresMs,
+			[pending = pendingCertificates, id](webrtc::scoped_refptr<webrtc::RTCCertificate> certificate) {
+				CertificateCallback callback = pending->take(id);
+
+				if (!callback) {
+					return;
+				}
+
+				if (certificate == nullptr) {
+					std::move(callback)(webrtc::RTCError(webrtc::RTCErrorType::INTERNAL_ERROR, "Generate certificate failed"));
+					return;
+				}
+
+				std::move(callback)(std::move(certificate));
+			});
+	}
+
+	uint64_t PeerConnectionFactoryShard::getOffloadedDatagrams() const
+	{
+#if defined(WEBRTC_LINUX)
+		if (batchingSocketServer) {
+			return batchingSocketServer->getOffloadedDatagrams();
+		}
+#endif
+		return 0;
+	}
+
+	bool PeerConnectionFactoryShard::processMessages(int timeoutMs)
+	{
+		if (applicationThread == nullptr) {
+			throw Exception("Factory was not created with an application signaling thread");
+		}
+		if (webrtc::Thread::Current() != applicationThread) {
+			throw Exception("Messages must be processed on the thread that created the factory");
+		}
+
+		return applicationThread->ProcessMessages(timeoutMs);
+	}
+
+	void PeerConnectionFactoryShard::flushSignalingThread()
+	{
+		if (applicationThread != nullptr) {
+			if (webrtc::Thread::Current() != applicationThread) {
+				return;
+			}
+
+			bool flushed = false;
+
+			applicationThread->PostTask([&flushed]() {
+				flushed = true;
+			});
+
+			while (!flushed && applicationThread->ProcessMessages(0)) {
+			}
+		}
+		else if (signalingRole != nullptr) {
+			// Tasks run in order, previously posted tasks have run on return.
+			signalingRole->BlockingCall([]() {});
+		}
+	}
+
+	std::unique_ptr<webrtc::PortAllocator> PeerConnectionFactoryShard::createPortAllocator(uint16_t sharedUdpPort, const NetworkFilter & networkFilter)
+	{
+		std::lock_guard<std::mutex> lock(socketFactoryMutex);
+
+		if (!networkManager) {
+			throw Exception("Factory has been disposed");
+		}
+
+		std::unique_ptr<FilteringNetworkManager> filteringNetworkManager;
+
+		if (!networkFilter.isEmpty()) {
+			filteringNetworkManager = std::make_unique<FilteringNetworkManager>(networkManager.get(), networkFilter);
+		}
+
+		if (sharedUdpPort != 0) {
+			webrtc::SocketServer * socketServer = networkThread->socketserver();
+
+			auto & port = sharedUdpPorts[sharedUdpPort];
+
+			if (!port) {
+				if (!IsUdpPortAvailable(sharedUdpPort)) {
+					sharedUdpPorts.erase(sharedUdpPort);
+
+					throw Exception("Shared UDP port %d is already in use", sharedUdpPort);
+				}
+
+				// Binds lazily on the network thread when the first ICE port is gathered.
+				port = std::make_shared<SharedUdpPort>(socketServer, sharedUdpPort);
+			}
+
+			// One socket factory per connection, the shared port routes by its sockets.
+			auto sharedUdpSocketFactory = std::make_unique<SharedUdpPacketSocketFactory>(socketServer, port);
+
+			return std::make_unique<SharedUdpPortAllocator>(environment, networkManager.get(),
+				std::move(filteringNetworkManager), std::move(sharedUdpSocketFactory));
+		}
+
+		if (filteringNetworkManager) {
+			return std::make_unique<FilteringPortAllocator>(environment, std::move(filteringNetworkManager), socketFactory.get());
+		}
+
+		return std::make_unique<webrtc::BasicPortAllocator>(environment, networkManager.get(), socketFactory.get());
+	}
+
+	bool PeerConnectionFactoryShard::dispose()
+	{
+		bool released = true;
+
+		if (factory) {
+			webrtc::PeerConnectionFactoryInterface * f = factory.release();
+
+			released = f->Release() == webrtc::RefCountReleaseStatus::kDroppedLastRef;
+		}
+
+		std::map<uint64_t, CertificateCallback> cancelled;
+
+		{
+			std::lock_guard<std::mutex> lock(pendingCertificates->mutex);
+
+			certificateGenerator = nullptr;
+			cancelled.swap(pendingCertificates->callbacks);
+		}
+
+		// Fail generations before their tasks are dropped with the threads.
+		for (auto & [id, callback] : cancelled) {
+			std::move(callback)(webrtc::RTCError(webrtc::RTCErrorType::INVALID_STATE, "Factory disposed before the certificate was generated"));
+		}
+
+		if (networkThread) {
+			// Shared ports own sockets of the network thread.
+			networkThread->BlockingCall([this]() {
+				std::lock_guard<std::mutex> lock(socketFactoryMutex);
+
+				sharedUdpPorts.clear();
+
+				if (networkManager) {
+					networkManager->StopUpdating();
+					networkManager = nullptr;
+				}
+
+				socketFactory = nullptr;
+			});
+
+			networkThread->Stop();
+			networkThread = nullptr;
+
+			batchingSocketServer = nullptr;
+		}
+		if (signalingThread) {
+			signalingThread->Stop();
+			signalingThread = nullptr;
+		}
+		if (workerThread) {
+			workerThread->Stop();
+			workerThread = nullptr;
+		}
+		if (applicationThread) {
+			// Unwrapping only affects the calling thread.
+			if (unwrapApplicationThread && webrtc::Thread::Current() == applicationThread) {
+				webrtc::ThreadManager::Instance()->UnwrapCurrentThread();
+			}
+
+			applicationThread = nullptr;
+		}
+
+		return released;
+	}
+
+	ShardedPeerConnectionFactory::ShardedPeerConnectionFactory(const PeerConnectionFactoryOptions & options) :
+		options(options)
+	{
+		if (options.shards < 1) {
+			throw Exception("Invalid number of factory shards: %d", options.shards);
+		}
+		if (options.applicationSignalingThread && options.shards != 1) {
+			throw Exception("An application signaling thread requires exactly one shard");
+		}
+
+		for (int i = 0; i < options.shards; i++) {
+			shards.push_back(std::make_unique<PeerConnectionFactoryShard>(options, i));
+		}
+	}
+
+	PeerConnectionFactoryShard * ShardedPeerConnectionFactory::selectShard()
+	{
+		PeerConnectionFactoryShard * selected = nullptr;
+
+		if (shards.size() > 1 && options.placement == PeerConnectionPlacement::kLeastLoaded) {
+			// Concurrent creates must not all see the same least-loaded shard.
+			while (true) {
+				int minLoad = std::numeric_limits<int>::max();
+
+				for (const auto & shard : shards) {
+					int load = shard->getLoad()->get();
+
+					if (load < minLoad) {
+						minLoad = load;
+						selected = shard.get();
+					}
+				}
+
+				if (selected->getLoad()->tryIncrement(minLoad)) {
+					return selected;
+				}
+			}
+		}
+
+		if (shards.size() == 1) {
+			selected = shards[0].get();
+		}
+		else {
+			selected = shards[nextShard.fetch_add(1, std::memory_order_relaxed) % shards.size()].get();
+		}
+
+		selected->getLoad()->increment();
+
+		return selected;
+	}
+
+	std::vector<int> ShardedPeerConnectionFactory::getLoad() const
+	{
+		std::vector<int> load;
+		load.reserve(shards.size());
+
+		for (const auto & shard : shards) {
+			load.push_back(shard->getLoad()->get());
+		}
+
+		return load;
+	}
+
+	void ShardedPeerConnectionFactory::generateCertificate(const webrtc::KeyParams & params, const std::optional<uint64_t> & expiresMs,
+		CertificateCallback callback)
+	{
+		const std::size_t index = nextCertificateShard.fetch_add(1, std::memory_order_relaxed) % shards.size();
+
+		shards[index]->generateCertificate(params, expiresMs, std::move(callback));
+	}
+
+	bool ShardedPeerConnectionFactory::isUdpOffloadSupported()
+	{
+#if defined(WEBRTC_LINUX)
+		return BatchingSocketServer::isUdpOffloadSupported();
+#else
+		return false;
+#endif
+	}
+
+	std::size_t ShardedPeerConnectionFactory::getShardCount() const
+	{
+		return shards.size();
+	}
+
+	uint64_t ShardedPeerConnectionFactory::getOffloadedDatagrams() const
+	{
+		uint64_t count = 0;
+
+		for (const auto & shard : shards) {
+			count += shard->getOffloadedDatagrams();
+		}
+
+		return count;
+	}
+
+	bool ShardedPeerConnectionFactory::processMessages(int timeoutMs)
+	{
+		return shards[0]->processMessages(timeoutMs);
+	}
+
+	void ShardedPeerConnectionFactory::flushSignalingThreads()
+	{
+		for (const auto & shard : shards) {
+			shard->flushSignalingThread();
+		}
+	}
+
+	bool ShardedPeerConnectionFactory::dispose()
+	{
+		bool released = true;
+
+		for (const auto & shard : shards) {
+			released &= shard->dispose();
+		}
+
+		return released;
+	}
+}
@@ -15,7 +15,12 @@
  */
 
 #include "WebRTCContext.h"
+#include "api/CompiledRTCConfiguration.h"
+#include "api/CompiledRTCDataChannelInit.h"
+#include "api/RTCCertificateRef.h"
 #include "api/RTCStats.h"
+#include "api/RTCStatsSerializer.h"
+#include "ShardedPeerConnectionFactory.h"
 #include "Exception.h"
 #include "JavaClassLoader.h"
 #include "JavaError.h"
@@ -26,7 +31,9 @@
 
 #include "api/environment/environment_factory.h"
 #include "api/peer_connection_interface.h"
+#include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_adapter.h"
+#include "rtc_base/ssl_identity.h"
 
 namespace jni
 {
@@ -56,11 +63,18 @@ namespace jni
 		JavaEnums::add<webrtc::PeerConnectionInterface::TlsCertPolicy>(env, PKG"TlsCertPolicy");
 		JavaEnums::add<webrtc::SdpType>(env, PKG"RTCSdpType");
 		JavaEnums::add<jni::RTCStats::RTCStatsType>(env, PKG"RTCStatsType");
+		JavaEnums::add<jni::RTCStatsSerializer::RTCStatsFormat>(env, PKG"RTCStatsFormat");
+		JavaEnums::add<jni::PeerConnectionPlacement>(env, PKG"PeerConnectionPlacement");
+		JavaEnums::add<jni::SocketServerType>(env, PKG"SocketServerType");
+		JavaEnums::add<webrtc::KeyType>(env, PKG"RTCKeyType");
 
 		JavaFactories::add<webrtc::DataChannelInterface>(env, PKG"RTCDataChannel");
 		JavaFactories::add<webrtc::DtlsTransportInterface>(env, PKG"RTCDtlsTransport");
 		JavaFactories::add<webrtc::IceTransportInterface>(env, PKG"RTCIceTransport");
 		JavaFactories::add<webrtc::PeerConnectionInterface>(env, PKG"RTCPeerConnection");
+		JavaFactories::add<jni::RTCCertificateRef>(env, PKG"RTCCertificate");
+		JavaFactories::add<jni::CompiledRTCConfiguration>(env, PKG"CompiledRTCConfiguration");
+		JavaFactories::add<jni::CompiledRTCDataChannelInit>(env, PKG"CompiledRTCDataChannelInit");
 
 		initializeClassLoader(env, PKG_INTERNAL"NativeClassLoader");
 	}
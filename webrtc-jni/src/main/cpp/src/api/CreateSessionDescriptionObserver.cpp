@@ -22,8 +22,10 @@
 
 namespace jni
 {
-	CreateSessionDescriptionObserver::CreateSessionDescriptionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer) :
+	CreateSessionDescriptionObserver::CreateSessionDescriptionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer, bool iceLite, bool sdpTemplate) :
 		observer(observer),
+		iceLite(iceLite),
+		sdpTemplate(sdpTemplate),
 		javaClass(JavaClasses::get<JavaCreateSessionDescObserverClass>(env))
 	{
 	}
@@ -32,7 +34,11 @@ namespace jni
 	{
 		JNIEnv * env = AttachCurrentThread();
 
-		JavaLocalRef<jobject> javaDesc = jni::RTCSessionDescription::toJava(env, desc);
+		if (iceLite) {
+			SetIceLiteMode(desc);
+		}
+
+		JavaLocalRef<jobject> javaDesc = jni::RTCSessionDescription::toJava(env, desc, sdpTemplate);
 
 		env->CallVoidMethod(observer, javaClass->onSuccess, javaDesc.get());
 
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/FutureObservers.h"
+#include "api/RTCSessionDescription.h"
+#include "api/RTCStatsReport.h"
+#include "api/WebRTCUtils.h"
+#include "JavaRuntimeException.h"
+#include "JNI_WebRTC.h"
+
+namespace jni
+{
+	JavaFuture::JavaFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future) :
+		future(future),
+		javaClass(JavaClasses::get<JavaCompletableFutureClass>(env))
+	{
+	}
+
+	void JavaFuture::complete(JNIEnv * env, jobject value)
+	{
+		env->CallBooleanMethod(future, javaClass->complete, value);
+
+		ExceptionCheck(env);
+	}
+
+	void JavaFuture::fail(JNIEnv * env, const webrtc::RTCError & error)
+	{
+		JavaLocalRef<jthrowable> exception(env, JavaRuntimeException(env, "%s", RTCErrorToString(error).c_str()));
+
+		env->CallBooleanMethod(future, javaClass->completeExceptionally, exception.get());
+
+		ExceptionCheck(env);
+	}
+
+	JavaFuture::JavaCompletableFutureClass::JavaCompletableFutureClass(JNIEnv * env)
+	{
+		jclass cls = FindClass(env, "java/util/concurrent/CompletableFuture");
+
+		complete = GetMethod(env, cls, "complete", "(Ljava/lang/Object;)Z");
+		completeExceptionally = GetMethod(env, cls, "completeExceptionally", "(Ljava/lang/Throwable;)Z");
+	}
+
+
+	CreateSessionDescriptionFuture::CreateSessionDescriptionFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future, bool iceLite, bool sdpTemplate) :
+		future(env, future),
+		iceLite(iceLite),
+		sdpTemplate(sdpTemplate)
+	{
+	}
+
+	void CreateSessionDescriptionFuture::OnSuccess(webrtc::SessionDescriptionInterface * desc)
+	{
+		std::unique_ptr<webrtc::SessionDescriptionInterface> description(desc);
+
+		JNIEnv * env = AttachCurrentThread();
+
+		if (iceLite) {
+			SetIceLiteMode(description.get());
+		}
+
+		try {
+			JavaLocalRef<jobject> javaDesc = jni::RTCSessionDescription::toJava(env, description.get(), sdpTemplate);
+
+			future.complete(env, javaDesc.get());
+		}
+		catch (const std::exception & e) {
+			// Called on the signaling thread, the exception must not escape.
+			future.fail(env, webrtc::RTCError(webrtc::RTCErrorType::INTERNAL_ERROR, e.what()));
+		}
+	}
+
+	void CreateSessionDescriptionFuture::OnFailure(webrtc::RTCError error)
+	{
+		future.fail(AttachCurrentThread(), error);
+	}
+
+
+	SetLocalDescriptionFuture::SetLocalDescriptionFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future) :
+		future(env, future)
+	{
+	}
+
+	void SetLocalDescriptionFuture::OnSetLocalDescriptionComplete(webrtc::RTCError error)
+	{
+		JNIEnv * env = AttachCurrentThread();
+
+		if (error.ok()) {
+			future.complete(env, nullptr);
+		}
+		else {
+			future.fail(env, error);
+		}
+	}
+
+
+	SetRemoteDescriptionFuture::SetRemoteDescriptionFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future) :
+		future(env, future)
+	{
+	}
+
+	void SetRemoteDescriptionFuture::OnSetRemoteDescriptionComplete(webrtc::RTCError error)
+	{
+		JNIEnv * env = AttachCurrentThread();
+
+		if (error.ok()) {
+			future.complete(env, nullptr);
+		}
+		else {
+			future.fail(env, error);
+		}
+	}
+
+
+	RTCStatsFuture::RTCStatsFuture(JNIEnv * env, const JavaGlobalRef<jobject> & future) :
+		future(env, future)
+	{
+	}
+
+	void RTCStatsFuture::OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport> & report)
+	{
+		JNIEnv * env = AttachCurrentThread();
+
+		JavaLocalRef<jobject> javaReport = jni::RTCStatsReport::toJava(env, report);
+
+		future.complete(env, javaReport.get());
+	}
+}
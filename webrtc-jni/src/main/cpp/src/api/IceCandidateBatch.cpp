@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/IceCandidateBatch.h"
+#include "api/WebRTCUtils.h"
+#include "JavaClasses.h"
+#include "JavaRef.h"
+#include "JavaString.h"
+#include "JavaUtils.h"
+
+namespace jni
+{
+	IceCandidateBatch::IceCandidateBatch(JNIEnv * env, const JavaGlobalRef<jobject> & future, std::size_t size) :
+		future(env, future),
+		candidates(size),
+		errors(size),
+		pending(0),
+		stringClass(JavaClasses::get<JavaStringClass>(env))
+	{
+	}
+
+	void IceCandidateBatch::parse(std::size_t index, const std::string & sdpMid, int sdpMLineIndex, const std::string & sdp)
+	{
+		webrtc::SdpParseError error;
+
+		candidates[index].reset(webrtc::CreateIceCandidate(sdpMid, sdpMLineIndex, sdp, &error));
+
+		if (candidates[index] == nullptr) {
+			errors[index] = "Create ICE candidate failed: " + error.description + " [" + error.line + "]";
+		}
+	}
+
+	void IceCandidateBatch::reject(std::size_t index, const std::string & error)
+	{
+		errors[index] = error;
+	}
+
+	void IceCandidateBatch::apply(webrtc::PeerConnectionInterface * pc)
+	{
+		// Count first, callbacks may run synchronously.
+		for (const auto & candidate : candidates) {
+			if (candidate != nullptr) {
+				pending++;
+			}
+		}
+
+		if (pending == 0) {
+			complete();
+			return;
+		}
+
+		auto self = shared_from_this();
+
+		for (std::size_t i = 0; i < candidates.size(); i++) {
+			if (candidates[i] == nullptr) {
+				continue;
+			}
+
+			pc->AddIceCandidate(std::move(candidates[i]), [self, i](webrtc::RTCError error) {
+				self->onAdded(i, error);
+			});
+		}
+	}
+
+	void IceCandidateBatch::onAdded(std::size_t index, const webrtc::RTCError & error)
+	{
+		if (!error.ok()) {
+			errors[index] = RTCErrorToString(error);
+		}
+
+		if (--pending == 0) {
+			complete();
+		}
+	}
+
+	void IceCandidateBatch::complete()
+	{
+		JNIEnv * env = AttachCurrentThread();
+
+		jsize size = static_cast<jsize>(errors.size());
+
+		JavaLocalRef<jobjectArray> result(env, env->NewObjectArray(size, stringClass->cls, nullptr));
+
+		for (jsize i = 0; i < size; i++) {
+			if (errors[i]) {
+				env->SetObjectArrayElement(result.get(), i, JavaString::toJava(env, *errors[i]).get());
+			}
+		}
+
+		future.complete(env, result.get());
+	}
+
+	IceCandidateBatch::JavaStringClass::JavaStringClass(JNIEnv * env)
+	{
+		cls = FindClass(env, "java/lang/String");
+	}
+}
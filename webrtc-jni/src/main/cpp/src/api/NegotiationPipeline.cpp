@@ -0,0 +1,136 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/NegotiationPipeline.h"
+#include "api/SdpTemplate.h"
+#include "api/WebRTCUtils.h"
+#include "JavaString.h"
+#include "JNI_WebRTC.h"
+
+#include "api/make_ref_counted.h"
+
+namespace jni
+{
+	NegotiationPipeline::NegotiationPipeline(JNIEnv * env, webrtc::scoped_refptr<webrtc::PeerConnectionInterface> pc,
+		const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions & options,
+		const JavaGlobalRef<jobject> & callback, bool iceLite, bool sdpTemplate) :
+		pc(pc),
+		options(options),
+		callback(callback),
+		iceLite(iceLite),
+		sdpTemplate(sdpTemplate),
+		javaClass(JavaClasses::get<JavaNegotiationCallbackClass>(env))
+	{
+	}
+
+	void NegotiationPipeline::createOffer()
+	{
+		pc->CreateOffer(this, options);
+	}
+
+	void NegotiationPipeline::answerOffer(std::unique_ptr<webrtc::SessionDescriptionInterface> offer)
+	{
+		auto observer = webrtc::make_ref_counted<RemoteDescriptionObserver>(webrtc::scoped_refptr<NegotiationPipeline>(this));
+
+		pc->SetRemoteDescription(std::move(offer), observer);
+	}
+
+	void NegotiationPipeline::OnSuccess(webrtc::SessionDescriptionInterface * desc)
+	{
+		std::unique_ptr<webrtc::SessionDescriptionInterface> description(desc);
+
+		if (iceLite) {
+			SetIceLiteMode(description.get());
+		}
+
+		sdp = SdpTemplate::serialize(*description, sdpTemplate);
+
+		// Called on the signaling thread, the next step runs synchronously.
+		auto observer = webrtc::make_ref_counted<LocalDescriptionObserver>(webrtc::scoped_refptr<NegotiationPipeline>(this));
+
+		pc->SetLocalDescription(std::move(description), observer);
+	}
+
+	void NegotiationPipeline::OnFailure(webrtc::RTCError error)
+	{
+		notifyFailure(error);
+	}
+
+	void NegotiationPipeline::onRemoteDescriptionSet(webrtc::RTCError error)
+	{
+		if (!error.ok()) {
+			notifyFailure(error);
+			return;
+		}
+
+		pc->CreateAnswer(this, options);
+	}
+
+	void NegotiationPipeline::onLocalDescriptionSet(webrtc::RTCError error)
+	{
+		if (!error.ok()) {
+			notifyFailure(error);
+			return;
+		}
+
+		JNIEnv * env = AttachCurrentThread();
+
+		JavaLocalRef<jstring> javaSdp = JavaString::toJava(env, sdp);
+
+		env->CallVoidMethod(callback, javaClass->onSuccess, javaSdp.get());
+
+		ExceptionCheck(env);
+	}
+
+	void NegotiationPipeline::notifyFailure(const webrtc::RTCError & error)
+	{
+		JNIEnv * env = AttachCurrentThread();
+
+		JavaLocalRef<jstring> errorMessage = JavaString::toJava(env, RTCErrorToString(error));
+
+		env->CallVoidMethod(callback, javaClass->onFailure, errorMessage.get());
+
+		ExceptionCheck(env);
+	}
+
+	NegotiationPipeline::RemoteDescriptionObserver::RemoteDescriptionObserver(webrtc::scoped_refptr<NegotiationPipeline> pipeline) :
+		pipeline(pipeline)
+	{
+	}
+
+	void NegotiationPipeline::RemoteDescriptionObserver::OnSetRemoteDescriptionComplete(webrtc::RTCError error)
+	{
+		pipeline->onRemoteDescriptionSet(std::move(error));
+	}
+
+	NegotiationPipeline::LocalDescriptionObserver::LocalDescriptionObserver(webrtc::scoped_refptr<NegotiationPipeline> pipeline) :
+		pipeline(pipeline)
+	{
+	}
+
+	void NegotiationPipeline::LocalDescriptionObserver::OnSetLocalDescriptionComplete(webrtc::RTCError error)
+	{
+		pipeline->onLocalDescriptionSet(std::move(error));
+	}
+
+	NegotiationPipeline::JavaNegotiationCallbackClass::JavaNegotiationCallbackClass(JNIEnv * env)
+	{
+		jclass cls = FindClass(env, PKG"NegotiationCallback");
+
+		onSuccess = GetMethod(env, cls, "onSuccess", "(" STRING_SIG ")V");
+		onFailure = GetMethod(env, cls, "onFailure", "(" STRING_SIG ")V");
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/PeerConnectionFactoryConfig.h"
+#include "JavaClasses.h"
+#include "JavaEnums.h"
+#include "JavaObject.h"
+#include "JavaUtils.h"
+#include "JNI_WebRTC.h"
+
+namespace jni
+{
+	namespace PeerConnectionFactoryConfig
+	{
+		PeerConnectionFactoryOptions toNative(JNIEnv * env, const JavaRef<jobject> & javaType)
+		{
+			const auto javaClass = JavaClasses::get<JavaPeerConnectionFactoryConfigClass>(env);
+
+			JavaObject obj(env, javaType);
+
+			PeerConnectionFactoryOptions options;
+			options.shards = obj.getInt(javaClass->shards);
+			options.singleThread = obj.getBoolean(javaClass->singleThread);
+			options.applicationSignalingThread = obj.getBoolean(javaClass->applicationSignalingThread);
+			options.udpOffload = obj.getBoolean(javaClass->udpOffload);
+
+			JavaLocalRef<jobject> placement = obj.getObject(javaClass->placement);
+
+			JavaLocalRef<jobject> socketServer = obj.getObject(javaClass->socketServer);
+
+			if (placement.get() != nullptr) {
+				options.placement = JavaEnums::toNative<PeerConnectionPlacement>(env, placement);
+			}
+			if (socketServer.get() != nullptr) {
+				options.socketServer = JavaEnums::toNative<SocketServerType>(env, socketServer);
+			}
+
+			return options;
+		}
+
+		JavaPeerConnectionFactoryConfigClass::JavaPeerConnectionFactoryConfigClass(JNIEnv * env)
+		{
+			cls = FindClass(env, PKG"PeerConnectionFactoryConfig");
+
+			shards = GetFieldID(env, cls, "shards", "I");
+			placement = GetFieldID(env, cls, "placement", "L" PKG "PeerConnectionPlacement;");
+			singleThread = GetFieldID(env, cls, "singleThread", "Z");
+			applicationSignalingThread = GetFieldID(env, cls, "applicationSignalingThread", "Z");
+			socketServer = GetFieldID(env, cls, "socketServer", "L" PKG "SocketServerType;");
+			udpOffload = GetFieldID(env, cls, "udpOffload", "Z");
+		}
+	}
+}
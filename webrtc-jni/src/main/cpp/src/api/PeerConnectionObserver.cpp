@@ -26,16 +26,29 @@
 #include "JavaUtils.h"
 #include "JNI_WebRTC.h"
 
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/thread.h"
+
 namespace jni
 {
-	PeerConnectionObserver::PeerConnectionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer) :
+	PeerConnectionObserver::PeerConnectionObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer, int candidateBatchWindow) :
 		observer(observer),
+		candidateBatchWindow(candidateBatchWindow),
 		javaClass(JavaClasses::get<JavaPeerConnectionObserverClass>(env))
 	{
 	}
 
+	void PeerConnectionObserver::close()
+	{
+		flushIceCandidates();
+	}
+
 	void PeerConnectionObserver::OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState state)
 	{
+		// Candidates are not held back across connection state changes.
+		flushIceCandidates();
+
 		JNIEnv * env = AttachCurrentThread();
 
 		auto jState = JavaEnums::toJava(env, state);
@@ -62,6 +75,9 @@ namespace jni
 
 		auto jDataChannel = JavaFactories::create(env, channel.release());
 
+		// Remote channels are announced on the signaling thread.
+		SetHandle(env, jDataChannel.get(), "signalingThreadHandle", webrtc::Thread::Current());
+
 		env->CallVoidMethod(observer, javaClass->onDataChannel, jDataChannel.get());
 
 		ExceptionCheck(env);
@@ -89,6 +105,10 @@ namespace jni
 
 	void PeerConnectionObserver::OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState state)
 	{
+		// Ends a window that waits for gathering to complete as well as a
+		// timed one, so no state change is reported ahead of its candidates.
+		flushIceCandidates();
+
 		JNIEnv * env = AttachCurrentThread();
 
 		auto jState = JavaEnums::toJava(env, state);
@@ -100,6 +120,23 @@ namespace jni
 
 	void PeerConnectionObserver::OnIceCandidate(const webrtc::IceCandidateInterface * candidate)
 	{
+		if (candidateBatchWindow != 0) {
+			// The candidate is only valid during this call.
+			pendingCandidates.push_back(webrtc::CreateIceCandidate(candidate->sdp_mid(), candidate->sdp_mline_index(), candidate->candidate()));
+
+			webrtc::Thread * thread = webrtc::Thread::Current();
+
+			if (thread == nullptr) {
+				flushIceCandidates();
+			}
+			else if (candidateBatchWindow > 0 && pendingCandidates.size() == 1) {
+				thread->PostDelayedTask(webrtc::SafeTask(safety.flag(), [this]() {
+					flushIceCandidates();
+				}), webrtc::TimeDelta::Millis(candidateBatchWindow));
+			}
+			return;
+		}
+
 		JNIEnv * env = AttachCurrentThread();
 
 		JavaLocalRef<jobject> jCandidate = RTCIceCandidate::toJava(env, candidate);
@@ -109,6 +146,32 @@ namespace jni
 		ExceptionCheck(env);
 	}
 
+	void PeerConnectionObserver::flushIceCandidates()
+	{
+		if (pendingCandidates.empty()) {
+			return;
+		}
+
+		JNIEnv * env = AttachCurrentThread();
+
+		const auto candidateClass = JavaClasses::get<RTCIceCandidate::JavaRTCIceCandidateClass>(env);
+		const jsize size = static_cast<jsize>(pendingCandidates.size());
+
+		JavaLocalRef<jobjectArray> jCandidates(env, env->NewObjectArray(size, candidateClass->cls, nullptr));
+
+		for (jsize i = 0; i < size; i++) {
+			JavaLocalRef<jobject> jCandidate = RTCIceCandidate::toJava(env, pendingCandidates[i].get());
+
+			env->SetObjectArrayElement(jCandidates.get(), i, jCandidate.get());
+		}
+
+		pendingCandidates.clear();
+
+		env->CallVoidMethod(observer, javaClass->onIceCandidates, jCandidates.get());
+
+		ExceptionCheck(env);
+	}
+
 	void PeerConnectionObserver::OnIceCandidateError(const std::string & address, int port, const std::string & url, int error_code, const std::string & error_text)
 	{
 		JNIEnv * env = AttachCurrentThread();
@@ -161,6 +224,7 @@ namespace jni
 		onIceConnectionChange = GetMethod(env, cls, "onIceConnectionChange", "(L" PKG "RTCIceConnectionState;)V");
 		onIceGatheringChange = GetMethod(env, cls, "onIceGatheringChange", "(L" PKG "RTCIceGatheringState;)V");
 		onIceCandidate = GetMethod(env, cls, "onIceCandidate", "(L" PKG "RTCIceCandidate;)V");
+		onIceCandidates = GetMethod(env, cls, "onIceCandidates", "([L" PKG "RTCIceCandidate;)V");
 		onIceCandidateError = GetMethod(env, cls, "onIceCandidateError", "(L" PKG "RTCPeerConnectionIceErrorEvent;)V");
 		onIceCandidatesRemoved = GetMethod(env, cls, "onIceCandidatesRemoved", "([L" PKG "RTCIceCandidate;)V");
 		onIceConnectionReceivingChange = GetMethod(env, cls, "onIceConnectionReceivingChange", "(Z)V");
@@ -15,16 +15,34 @@
  */
 
 #include "api/PortAllocatorConfig.h"
+#include "Exception.h"
+#include "JavaArrayList.h"
 #include "JavaClasses.h"
+#include "JavaIllegalArgumentException.h"
+#include "JavaList.h"
 #include "JavaObject.h"
+#include "JavaString.h"
 #include "JavaUtils.h"
+#include "JavaWrappedException.h"
 #include "JNI_WebRTC.h"
 
 namespace jni
 {
 	namespace PortAllocatorConfig
 	{
-		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::PortAllocatorConfig & cfg)
+		static JavaLocalRef<jobject> toStringList(JNIEnv * env, const std::vector<std::string> & values)
+		{
+			JavaArrayList list(env, values.size());
+
+			for (const auto & value : values) {
+				list.add(JavaLocalRef<jobject>(env, JavaString::toJava(env, value).release()));
+			}
+
+			return list.listObject();
+		}
+
+		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::PortAllocatorConfig & cfg,
+			int sharedUdpPort, const NetworkFilter & filter)
 		{
 			const auto javaClass = JavaClasses::get<JavaPortAllocatorConfigClass>(env);
 
@@ -34,10 +52,66 @@ namespace jni
 			obj.setInt(javaClass->minPort, cfg.min_port);
 			obj.setInt(javaClass->maxPort, cfg.max_port);
 			obj.setInt(javaClass->flags, cfg.flags);
+			obj.setInt(javaClass->sharedUdpPort, sharedUdpPort);
+			obj.setInt(javaClass->networkIgnoreMask, filter.ignoreMask);
+			obj.setBoolean(javaClass->disableIpv6, filter.disableIpv6);
+			obj.setInt(javaClass->maxNetworksPerInterface, filter.maxNetworksPerInterface);
+
+			env->SetObjectField(jpac, javaClass->interfaceAllowList, toStringList(env, filter.allowList).get());
+			env->SetObjectField(jpac, javaClass->interfaceDenyList, toStringList(env, filter.denyList).get());
 
 			return JavaLocalRef<jobject>(env, jpac);
 		}
 
+		int getSharedUdpPort(JNIEnv * env, const JavaRef<jobject> & javaType)
+		{
+			if (javaType.get() == nullptr) {
+				return 0;
+			}
+
+			const auto javaClass = JavaClasses::get<JavaPortAllocatorConfigClass>(env);
+
+			JavaObject obj(env, javaType);
+
+			return obj.getInt(javaClass->sharedUdpPort);
+		}
+
+		NetworkFilter toNetworkFilter(JNIEnv * env, const JavaRef<jobject> & javaType)
+		{
+			NetworkFilter filter;
+
+			if (javaType.get() == nullptr) {
+				return filter;
+			}
+
+			const auto javaClass = JavaClasses::get<JavaPortAllocatorConfigClass>(env);
+
+			JavaObject obj(env, javaType);
+
+			JavaLocalRef<jobject> allow = obj.getObject(javaClass->interfaceAllowList);
+			JavaLocalRef<jobject> deny = obj.getObject(javaClass->interfaceDenyList);
+
+			if (allow.get() != nullptr) {
+				filter.allowList = JavaList::toStringVector(env, allow);
+			}
+			if (deny.get() != nullptr) {
+				filter.denyList = JavaList::toStringVector(env, deny);
+			}
+
+			filter.ignoreMask = obj.getInt(javaClass->networkIgnoreMask);
+			filter.disableIpv6 = obj.getBoolean(javaClass->disableIpv6);
+			filter.maxNetworksPerInterface = obj.getInt(javaClass->maxNetworksPerInterface);
+
+			try {
+				FilteringNetworkManager::validate(filter);
+			}
+			catch (const Exception & e) {
+				throw JavaWrappedException(JavaLocalRef<jthrowable>(env, JavaIllegalArgumentException(env, "%s", e.what())));
+			}
+
+			return filter;
+		}
+
 		JavaPortAllocatorConfigClass::JavaPortAllocatorConfigClass(JNIEnv * env)
 		{
 			cls = FindClass(env, PKG"PortAllocatorConfig");
@@ -45,6 +119,12 @@ namespace jni
 			minPort = GetFieldID(env, cls, "minPort", "I");
 			maxPort = GetFieldID(env, cls, "maxPort", "I");
 			flags = GetFieldID(env, cls, "flags", "I");
+			sharedUdpPort = GetFieldID(env, cls, "sharedUdpPort", "I");
+			interfaceAllowList = GetFieldID(env, cls, "interfaceAllowList", LIST_SIG);
+			interfaceDenyList = GetFieldID(env, cls, "interfaceDenyList", LIST_SIG);
+			networkIgnoreMask = GetFieldID(env, cls, "networkIgnoreMask", "I");
+			disableIpv6 = GetFieldID(env, cls, "disableIpv6", "Z");
+			maxNetworksPerInterface = GetFieldID(env, cls, "maxNetworksPerInterface", "I");
 		}
 	}
 }
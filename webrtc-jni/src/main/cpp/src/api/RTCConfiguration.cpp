@@ -17,7 +17,9 @@
 #include "api/RTCConfiguration.h"
 #include "api/RTCIceServer.h"
 #include "api/PortAllocatorConfig.h"
+#include "api/RTCCertificateRef.h"
 #include "rtc/RTCCertificatePEM.h"
+#include "Exception.h"
 #include "JavaArrayList.h"
 #include "JavaClasses.h"
 #include "JavaEnums.h"
@@ -32,7 +34,7 @@ namespace jni
 {
 	namespace RTCConfiguration
 	{
-		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::RTCConfiguration & nativeType)
+		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::PeerConnectionInterface::RTCConfiguration & nativeType, const PeerConnectionOptions & options)
 		{
 			const auto javaClass = JavaClasses::get<JavaRTCConfigurationClass>(env);
 
@@ -57,8 +59,12 @@ namespace jni
 			env->SetObjectField(config, javaClass->rtcpMuxPolicy, rtcpMuxPolicy.get());
 			env->SetObjectField(config, javaClass->certificates, certificateList.listObject());
 
-			auto pac = jni::PortAllocatorConfig::toJava(env, nativeType.port_allocator_config);
+			auto pac = jni::PortAllocatorConfig::toJava(env, nativeType.port_allocator_config, options.sharedUdpPort, options.networkFilter);
 			env->SetObjectField(config, javaClass->portAllocatorConfig, pac.get());
+			env->SetIntField(config, javaClass->iceCandidatePoolSize, nativeType.ice_candidate_pool_size);
+			env->SetBooleanField(config, javaClass->iceLite, options.iceLite);
+			env->SetIntField(config, javaClass->iceCandidateBatchWindow, options.iceCandidateBatchWindow);
+			env->SetBooleanField(config, javaClass->sdpTemplate, options.sdpTemplate);
 
 			return JavaLocalRef<jobject>(env, config);
 		}
@@ -74,6 +80,7 @@ namespace jni
 			JavaLocalRef<jobject> bp = obj.getObject(javaClass->bundlePolicy);
 			JavaLocalRef<jobject> mp = obj.getObject(javaClass->rtcpMuxPolicy);
 			JavaLocalRef<jobject> cr = obj.getObject(javaClass->certificates);
+			JavaLocalRef<jobject> nc = obj.getObject(javaClass->nativeCertificates);
 			JavaLocalRef<jobject> pac = obj.getObject(javaClass->portAllocatorConfig);
 
 			webrtc::PeerConnectionInterface::RTCConfiguration configuration;
@@ -83,6 +90,7 @@ namespace jni
 			configuration.type = JavaEnums::toNative<webrtc::PeerConnectionInterface::IceTransportsType>(env, tp);
 			configuration.bundle_policy = JavaEnums::toNative<webrtc::PeerConnectionInterface::BundlePolicy>(env, bp);
 			configuration.rtcp_mux_policy = JavaEnums::toNative<webrtc::PeerConnectionInterface::RtcpMuxPolicy>(env, mp);
+			configuration.ice_candidate_pool_size = obj.getInt(javaClass->iceCandidatePoolSize);
 			
 			for (auto & item : JavaIterable(env, cr)) {
 				auto certificate = webrtc::RTCCertificate::FromPEM(jni::RTCCertificatePEM::toNative(env, item));
@@ -94,6 +102,19 @@ namespace jni
 				}
 			}
 
+			if (nc.get() != nullptr) {
+				// Pre-generated certificates are shared without a PEM round trip.
+				for (auto & item : JavaIterable(env, nc)) {
+					auto ref = static_cast<RTCCertificateRef *>(GetHandle<webrtc::RefCountInterface>(env, item.get()));
+
+					if (ref == nullptr) {
+						throw Exception("RTCCertificate has been released");
+					}
+
+					configuration.certificates.push_back(ref->get());
+				}
+			}
+
 			if (pac.get() != nullptr) {
 				const auto pacJavaClass = JavaClasses::get<PortAllocatorConfig::JavaPortAllocatorConfigClass>(env);
 				JavaObject pacObj(env, pac);
@@ -103,9 +124,36 @@ namespace jni
 				configuration.port_allocator_config.flags = pacObj.getInt(pacJavaClass->flags);
 			}
 
+			if (obj.getBoolean(javaClass->iceLite)) {
+				// A lite agent only offers host candidates, gathered once.
+				configuration.servers.clear();
+				configuration.continual_gathering_policy = webrtc::PeerConnectionInterface::GATHER_ONCE;
+				configuration.port_allocator_config.flags |= webrtc::PORTALLOCATOR_DISABLE_STUN
+					| webrtc::PORTALLOCATOR_DISABLE_RELAY
+					| webrtc::PORTALLOCATOR_DISABLE_TCP;
+			}
+
 			return configuration;
 		}
 
+		PeerConnectionConfiguration toPeerConnectionConfiguration(JNIEnv * env, const JavaRef<jobject> & javaType)
+		{
+			const auto javaClass = JavaClasses::get<JavaRTCConfigurationClass>(env);
+
+			JavaObject obj(env, javaType);
+			JavaLocalRef<jobject> pac = obj.getObject(javaClass->portAllocatorConfig);
+
+			PeerConnectionConfiguration config;
+			config.configuration = toNative(env, javaType);
+			config.options.networkFilter = PortAllocatorConfig::toNetworkFilter(env, pac);
+			config.options.sharedUdpPort = PortAllocatorConfig::getSharedUdpPort(env, pac);
+			config.options.iceLite = obj.getBoolean(javaClass->iceLite);
+			config.options.iceCandidateBatchWindow = obj.getInt(javaClass->iceCandidateBatchWindow);
+			config.options.sdpTemplate = obj.getBoolean(javaClass->sdpTemplate);
+
+			return config;
+		}
+
 		JavaRTCConfigurationClass::JavaRTCConfigurationClass(JNIEnv * env)
 		{
 			cls = FindClass(env, PKG"RTCConfiguration");
@@ -117,7 +165,12 @@ namespace jni
 			bundlePolicy = GetFieldID(env, cls, "bundlePolicy", "L" PKG "RTCBundlePolicy;");
 			rtcpMuxPolicy = GetFieldID(env, cls, "rtcpMuxPolicy", "L" PKG "RTCRtcpMuxPolicy;");
 			certificates = GetFieldID(env, cls, "certificates", LIST_SIG);
+			nativeCertificates = GetFieldID(env, cls, "nativeCertificates", LIST_SIG);
 			portAllocatorConfig = GetFieldID(env, cls, "portAllocatorConfig", "L" PKG "PortAllocatorConfig;");
+			iceCandidatePoolSize = GetFieldID(env, cls, "iceCandidatePoolSize", "I");
+			iceLite = GetFieldID(env, cls, "iceLite", "Z");
+			iceCandidateBatchWindow = GetFieldID(env, cls, "iceCandidateBatchWindow", "I");
+			sdpTemplate = GetFieldID(env, cls, "sdpTemplate", "Z");
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/RTCDataChannelDrain.h"
+#include "JavaPrimitive.h"
+#include "JNI_WebRTC.h"
+
+namespace jni
+{
+	uint64_t RTCDataChannelDrain::start(JNIEnv * env, webrtc::DataChannelInterface * channel,
+		const JavaGlobalRef<jobject> & future)
+	{
+		auto pending = std::make_unique<JavaFuture>(env, future);
+
+		std::unique_lock<std::recursive_mutex> lock(mutex);
+
+		if (this->future) {
+			lock.unlock();
+
+			pending->fail(env, webrtc::RTCError(webrtc::RTCErrorType::INVALID_STATE, "Data channel is already draining"));
+			return 0;
+		}
+
+		this->channel = channel;
+		this->future = std::move(pending);
+
+		return ++generation;
+	}
+
+	void RTCDataChannelDrain::check()
+	{
+		std::unique_lock<std::recursive_mutex> lock(mutex);
+
+		if (!channel) {
+			return;
+		}
+
+		const bool empty = channel->buffered_amount() == 0;
+
+		if (empty || channel->state() >= webrtc::DataChannelInterface::kClosing) {
+			finish(lock, empty);
+		}
+	}
+
+	void RTCDataChannelDrain::expire(uint64_t generation)
+	{
+		std::unique_lock<std::recursive_mutex> lock(mutex);
+
+		if (channel && generation == this->generation) {
+			finish(lock, channel->buffered_amount() == 0);
+		}
+	}
+
+	void RTCDataChannelDrain::cancel(JNIEnv * env)
+	{
+		std::unique_lock<std::recursive_mutex> lock(mutex);
+
+		channel = nullptr;
+
+		std::unique_ptr<JavaFuture> pending = std::move(future);
+
+		lock.unlock();
+
+		if (pending) {
+			pending->fail(env, webrtc::RTCError(webrtc::RTCErrorType::INVALID_STATE, "Data channel disposed before drained"));
+		}
+	}
+
+	void RTCDataChannelDrain::finish(std::unique_lock<std::recursive_mutex> & lock, bool drained)
+	{
+		webrtc::DataChannelInterface * closing = channel;
+		std::unique_ptr<JavaFuture> pending = std::move(future);
+
+		// Forget the channel first, closing re-enters check() via the observer.
+		channel = nullptr;
+
+		// Close while locked, so that the wrapper cannot release the channel meanwhile.
+		closing->Close();
+
+		lock.unlock();
+
+		JNIEnv * env = AttachCurrentThread();
+
+		JavaLocalRef<jobject> result = Boolean::create(env, drained);
+
+		pending->complete(env, result.get());
+	}
+}
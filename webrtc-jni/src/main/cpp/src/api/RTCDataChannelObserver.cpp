@@ -20,15 +20,27 @@
 
 namespace jni
 {
-	RTCDataChannelObserver::RTCDataChannelObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer) :
+	RTCDataChannelObserver::RTCDataChannelObserver(JNIEnv * env, const JavaGlobalRef<jobject> & observer,
+		webrtc::scoped_refptr<RTCDataChannelCounters> counters, webrtc::scoped_refptr<RTCDataChannelDrain> drain) :
 		observer(observer),
 		bufferFactory(std::make_unique<DataBufferFactory>(env, PKG"RTCDataChannelBuffer")),
+		counters(std::move(counters)),
+		drain(std::move(drain)),
 		javaClass(JavaClasses::get<JavaRTCDataChannelObserverClass>(env))
 	{
 	}
 
 	void RTCDataChannelObserver::OnStateChange()
 	{
+		if (drain) {
+			drain->check();
+		}
+
+		// Drain-only observer without a Java counterpart.
+		if (observer.get() == nullptr) {
+			return;
+		}
+
 		JNIEnv * env = AttachCurrentThread();
 
 		env->CallVoidMethod(observer, javaClass->onStateChange);
@@ -38,6 +50,14 @@ namespace jni
 
 	void RTCDataChannelObserver::OnMessage(const webrtc::DataBuffer & buffer)
 	{
+		if (counters) {
+			counters->messageReceived(buffer.size());
+		}
+
+		if (observer.get() == nullptr) {
+			return;
+		}
+
 		JNIEnv * env = AttachCurrentThread();
 
 		JavaLocalRef<jobject> jBuffer = bufferFactory->create(env, &buffer);
@@ -49,6 +69,14 @@ namespace jni
 
 	void RTCDataChannelObserver::OnBufferedAmountChange(uint64_t sent_data_size)
 	{
+		if (drain) {
+			drain->check();
+		}
+
+		if (observer.get() == nullptr) {
+			return;
+		}
+
 		JNIEnv * env = AttachCurrentThread();
 
 		env->CallVoidMethod(observer, javaClass->onBufferedAmountChange, static_cast<jlong>(sent_data_size));
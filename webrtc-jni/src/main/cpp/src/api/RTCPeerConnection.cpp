@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/RTCPeerConnection.h"
+#include "JavaUtils.h"
+
+namespace jni
+{
+	namespace RTCPeerConnection
+	{
+		void setOptions(JNIEnv * env, jobject javaType, const PeerConnectionOptions & options)
+		{
+			SetHandle(env, javaType, "optionsHandle", new PeerConnectionOptions(options));
+		}
+
+		const PeerConnectionOptions * getOptions(JNIEnv * env, jobject javaType)
+		{
+			return GetHandle<const PeerConnectionOptions>(env, javaType, "optionsHandle");
+		}
+
+		PeerConnectionOptions * detachOptions(JNIEnv * env, jobject javaType)
+		{
+			auto options = GetHandle<PeerConnectionOptions>(env, javaType, "optionsHandle");
+
+			SetHandle<std::nullptr_t>(env, javaType, "optionsHandle", nullptr);
+
+			return options;
+		}
+
+		bool isIceLite(JNIEnv * env, jobject javaType)
+		{
+			const PeerConnectionOptions * options = getOptions(env, javaType);
+
+			return options != nullptr && options->iceLite;
+		}
+
+		bool useSdpTemplate(JNIEnv * env, jobject javaType)
+		{
+			const PeerConnectionOptions * options = getOptions(env, javaType);
+
+			return options != nullptr && options->sdpTemplate;
+		}
+	}
+}
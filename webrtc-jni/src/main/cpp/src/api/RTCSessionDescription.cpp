@@ -15,6 +15,7 @@
  */
 
 #include "api/RTCSessionDescription.h"
+#include "api/SdpTemplate.h"
 #include "JavaClasses.h"
 #include "JavaEnums.h"
 #include "JavaObject.h"
@@ -28,12 +29,11 @@ namespace jni
 {
 	namespace RTCSessionDescription
 	{
-		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::SessionDescriptionInterface * nativeType)
+		JavaLocalRef<jobject> toJava(JNIEnv * env, const webrtc::SessionDescriptionInterface * nativeType, bool sdpTemplate)
 		{
 			const auto javaClass = JavaClasses::get<JavaRTCSessionDescriptionClass>(env);
 
-			std::string sdpStr;
-			nativeType->ToString(&sdpStr);
+			std::string sdpStr = SdpTemplate::serialize(*nativeType, sdpTemplate);
 
 			JavaLocalRef<jobject> type = JavaEnums::toJava(env, nativeType->GetType());
 			JavaLocalRef<jstring> sdp = JavaString::toJava(env, sdpStr);
@@ -43,7 +43,7 @@ namespace jni
 			return JavaLocalRef<jobject>(env, obj);
 		}
 
-		std::unique_ptr<webrtc::SessionDescriptionInterface> toNative(JNIEnv * env, const JavaRef<jobject>& javaType)
+		std::unique_ptr<webrtc::SessionDescriptionInterface> toNative(JNIEnv * env, const JavaRef<jobject>& javaType, bool sdpTemplate)
 		{
 			const auto javaClass = JavaClasses::get<JavaRTCSessionDescriptionClass>(env);
 
@@ -56,7 +56,7 @@ namespace jni
 			std::string sdp = JavaString::toNative(env, jSdp);
 			webrtc::SdpParseError error;
 
-			auto desc = webrtc::CreateSessionDescription(type, sdp, &error);
+			auto desc = SdpTemplate::deserialize(type, sdp, &error, sdpTemplate);
 
 			if (desc == nullptr) {
 				throw Exception("Create session description failed: %s [%s]", error.description.c_str(), error.line.c_str());
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/RTCStatsSerializedCallback.h"
+#include "JNI_WebRTC.h"
+
+#include <string>
+
+namespace jni
+{
+	RTCStatsSerializedCallback::RTCStatsSerializedCallback(JNIEnv * env, const JavaGlobalRef<jobject> & callback, RTCStatsSerializer::RTCStatsFormat format) :
+		callback(callback),
+		format(format),
+		javaClass(JavaClasses::get<JavaRTCStatsSerializedCallbackClass>(env))
+	{
+	}
+
+	void RTCStatsSerializedCallback::OnStatsDelivered(const webrtc::scoped_refptr<const webrtc::RTCStatsReport> & report)
+	{
+		JNIEnv * env = AttachCurrentThread();
+
+		const std::string data = RTCStatsSerializer::serialize(*report, format);
+		const jsize length = static_cast<jsize>(data.size());
+
+		JavaLocalRef<jbyteArray> javaData(env, env->NewByteArray(length));
+		ExceptionCheck(env);
+
+		env->SetByteArrayRegion(javaData, 0, length, reinterpret_cast<const jbyte *>(data.data()));
+
+		env->CallVoidMethod(callback, javaClass->onStatsDelivered, javaData.get());
+
+		ExceptionCheck(env);
+	}
+
+	RTCStatsSerializedCallback::JavaRTCStatsSerializedCallbackClass::JavaRTCStatsSerializedCallbackClass(JNIEnv * env)
+	{
+		jclass cls = FindClass(env, PKG"RTCStatsSerializedCallback");
+
+		onStatsDelivered = GetMethod(env, cls, "onStatsDelivered", "([B)V");
+	}
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/RTCStatsSerializer.h"
+
+#include "api/stats/attribute.h"
+#include "api/stats/rtc_stats.h"
+
+#include <bit>
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace jni
+{
+	namespace RTCStatsSerializer
+	{
+		enum class AttributeTag : uint8_t {
+			kBool,
+			kInt32,
+			kUint32,
+			kInt64,
+			kUint64,
+			kDouble,
+			kString,
+			kBoolSequence,
+			kInt32Sequence,
+			kUint32Sequence,
+			kInt64Sequence,
+			kUint64Sequence,
+			kDoubleSequence,
+			kStringSequence,
+			kUint64Map,
+			kDoubleMap
+		};
+
+		template <typename T>
+		static void write(std::string & out, T value)
+		{
+			static_assert(std::is_arithmetic<T>::value, "Arithmetic type required");
+
+			uint8_t bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+
+			// Emit little-endian regardless of the host byte order.
+			if constexpr (std::endian::native == std::endian::big) {
+				for (size_t i = sizeof(T); i > 0; i--) {
+					out.push_back(static_cast<char>(bytes[i - 1]));
+				}
+			}
+			else {
+				out.append(reinterpret_cast<const char *>(bytes), sizeof(T));
+			}
+		}
+
+		static void write(std::string & out, const std::string & value)
+		{
+			write<uint32_t>(out, static_cast<uint32_t>(value.size()));
+			out.append(value);
+		}
+
+		static void write(std::string & out, bool value)
+		{
+			write<uint8_t>(out, value ? 1 : 0);
+		}
+
+		template <typename T>
+		static void writeSequence(std::string & out, const std::vector<T> & values)
+		{
+			write<uint32_t>(out, static_cast<uint32_t>(values.size()));
+
+			for (const auto & value : values) {
+				write(out, value);
+			}
+		}
+
+		template <typename T>
+		static void writeMap(std::string & out, const std::map<std::string, T> & values)
+		{
+			write<uint32_t>(out, static_cast<uint32_t>(values.size()));
+
+			for (const auto & item : values) {
+				write(out, item.first);
+				write(out, item.second);
+			}
+		}
+
+		static void writeTag(std::string & out, AttributeTag tag)
+		{
+			write<uint8_t>(out, static_cast<uint8_t>(tag));
+		}
+
+		static bool writeAttribute(std::string & out, const webrtc::Attribute & attribute)
+		{
+			if (attribute.holds_alternative<bool>()) {
+				writeTag(out, AttributeTag::kBool);
+				write(out, attribute.get<bool>());
+			}
+			else if (attribute.holds_alternative<int32_t>()) {
+				writeTag(out, AttributeTag::kInt32);
+				write(out, attribute.get<int32_t>());
+			}
+			else if (attribute.holds_alternative<uint32_t>()) {
+				writeTag(out, AttributeTag::kUint32);
+				write(out, attribute.get<uint32_t>());
+			}
+			else if (attribute.holds_alternative<int64_t>()) {
+				writeTag(out, AttributeTag::kInt64);
+				write(out, attribute.get<int64_t>());
+			}
+			else if (attribute.holds_alternative<uint64_t>()) {
+				writeTag(out, AttributeTag::kUint64);
+				write(out, attribute.get<uint64_t>());
+			}
+			else if (attribute.holds_alternative<double>()) {
+				writeTag(out, AttributeTag::kDouble);
+				write(out, attribute.get<double>());
+			}
+			else if (attribute.holds_alternative<std::string>()) {
+				writeTag(out, AttributeTag::kString);
+				write(out, attribute.get<std::string>());
+			}
+			else if (attribute.holds_alternative<std::vector<bool>>()) {
+				writeTag(out, AttributeTag::kBoolSequence);
+				writeSequence(out, attribute.get<std::vector<bool>>());
+			}
+			else if (attribute.holds_alternative<std::vector<int32_t>>()) {
+				writeTag(out, AttributeTag::kInt32Sequence);
+				writeSequence(out, attribute.get<std::vector<int32_t>>());
+			}
+			else if (attribute.holds_alternative<std::vector<uint32_t>>()) {
+				writeTag(out, AttributeTag::kUint32Sequence);
+				writeSequence(out, attribute.get<std::vector<uint32_t>>());
+			}
+			else if (attribute.holds_alternative<std::vector<int64_t>>()) {
+				writeTag(out, AttributeTag::kInt64Sequence);
+				writeSequence(out, attribute.get<std::vector<int64_t>>());
+			}
+			else if (attribute.holds_alternative<std::vector<uint64_t>>()) {
+				writeTag(out, AttributeTag::kUint64Sequence);
+				writeSequence(out, attribute.get<std::vector<uint64_t>>());
+			}
+			else if (attribute.holds_alternative<std::vector<double>>()) {
+				writeTag(out, AttributeTag::kDoubleSequence);
+				writeSequence(out, attribute.get<std::vector<double>>());
+			}
+			else if (attribute.holds_alternative<std::vector<std::string>>()) {
+				writeTag(out, AttributeTag::kStringSequence);
+				writeSequence(out, attribute.get<std::vector<std::string>>());
+			}
+			else if (attribute.holds_alternative<std::map<std::string, uint64_t>>()) {
+				writeTag(out, AttributeTag::kUint64Map);
+				writeMap(out, attribute.get<std::map<std::string, uint64_t>>());
+			}
+			else if (attribute.holds_alternative<std::map<std::string, double>>()) {
+				writeTag(out, AttributeTag::kDoubleMap);
+				writeMap(out, attribute.get<std::map<std::string, double>>());
+			}
+			else {
+				return false;
+			}
+
+			return true;
+		}
+
+		static std::string toBinary(const webrtc::RTCStatsReport & report)
+		{
+			std::string out;
+			std::string attributes;
+
+			write<int64_t>(out, report.timestamp().us());
+			write<uint32_t>(out, static_cast<uint32_t>(report.size()));
+
+			for (const auto & stats : report) {
+				uint32_t attributeCount = 0;
+
+				attributes.clear();
+
+				for (const auto & attribute : stats.Attributes()) {
+					if (!attribute.has_value()) {
+						continue;
+					}
+
+					const size_t mark = attributes.size();
+
+					write(attributes, std::string(attribute.name()));
+
+					if (writeAttribute(attributes, attribute)) {
+						attributeCount++;
+					}
+					else {
+						// Unknown attribute type, drop the already written name.
+						attributes.resize(mark);
+					}
+				}
+
+				write(out, stats.id());
+				write(out, std::string(stats.type()));
+				write<int64_t>(out, stats.timestamp().us());
+				write<uint32_t>(out, attributeCount);
+
+				out.append(attributes);
+			}
+
+			return out;
+		}
+
+		std::string serialize(const webrtc::RTCStatsReport & report, RTCStatsFormat format)
+		{
+			switch (format) {
+				case RTCStatsFormat::kJson:
+					return report.ToJson();
+
+				case RTCStatsFormat::kBinary:
+					return toBinary(report);
+			}
+
+			return std::string();
+		}
+	}
+}
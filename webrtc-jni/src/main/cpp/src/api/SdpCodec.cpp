@@ -0,0 +1,542 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/SdpCodec.h"
+#include "api/SdpTemplate.h"
+#include "Exception.h"
+
+#include "api/array_view.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/ssl_fingerprint.h"
+
+#include <charconv>
+#include <string>
+
+namespace jni
+{
+	namespace SdpCodec
+	{
+		static const uint8_t kVersion = 2;
+
+		// Index of a well-known token, followed by a string if not listed.
+		static const uint8_t kCustomToken = 0xFF;
+
+		static const std::vector<std::string> kProtocols = { "udp", "tcp", "ssltcp", "tls" };
+		static const std::vector<std::string> kTcpTypes = { "", "active", "passive", "so" };
+		static const std::vector<std::string> kHashAlgorithms = { "sha-256", "sha-384", "sha-512", "sha-1" };
+
+		enum Flags : uint8_t {
+			kIceLite = 1 << 0,
+			kTrickle = 1 << 1,
+			kExtmapAllowMixed = 1 << 2,
+			kMsidSemantic = 1 << 3
+		};
+
+		enum AddressKind : uint8_t {
+			kHostname = 0,
+			kIPv4 = 4,
+			kIPv6 = 6
+		};
+
+
+		class Writer
+		{
+			public:
+				void u8(uint8_t value)
+				{
+					data.push_back(value);
+				}
+
+				void u16(uint16_t value)
+				{
+					u8(static_cast<uint8_t>(value >> 8));
+					u8(static_cast<uint8_t>(value));
+				}
+
+				void u32(uint32_t value)
+				{
+					u16(static_cast<uint16_t>(value >> 16));
+					u16(static_cast<uint16_t>(value));
+				}
+
+				void u64(uint64_t value)
+				{
+					u32(static_cast<uint32_t>(value >> 32));
+					u32(static_cast<uint32_t>(value));
+				}
+
+				void bytes(const uint8_t * src, std::size_t size)
+				{
+					if (size > 0xFF) {
+						throw Exception("SDP value too long to encode: %zu bytes", size);
+					}
+
+					u8(static_cast<uint8_t>(size));
+					data.insert(data.end(), src, src + size);
+				}
+
+				void string(const std::string & value)
+				{
+					bytes(reinterpret_cast<const uint8_t *>(value.data()), value.size());
+				}
+
+				// ICE credentials may exceed 255 characters, use a two byte length.
+				void longString(const std::string & value)
+				{
+					if (value.size() > 0xFFFF) {
+						throw Exception("SDP value too long to encode: %zu bytes", value.size());
+					}
+
+					u16(static_cast<uint16_t>(value.size()));
+					data.insert(data.end(), value.begin(), value.end());
+				}
+
+				void token(const std::vector<std::string> & tokens, const std::string & value)
+				{
+					for (std::size_t i = 0; i < tokens.size(); i++) {
+						if (tokens[i] == value) {
+							u8(static_cast<uint8_t>(i));
+							return;
+						}
+					}
+
+					u8(kCustomToken);
+					string(value);
+				}
+
+				std::vector<uint8_t> data;
+		};
+
+
+		class Reader
+		{
+			public:
+				Reader(const uint8_t * data, std::size_t size) :
+					data(data),
+					size(size),
+					offset(0)
+				{
+				}
+
+				uint8_t u8()
+				{
+					require(1);
+
+					return data[offset++];
+				}
+
+				uint16_t u16()
+				{
+					uint16_t value = u8();
+					return static_cast<uint16_t>((value << 8) | u8());
+				}
+
+				uint32_t u32()
+				{
+					uint32_t value = u16();
+					return (value << 16) | u16();
+				}
+
+				uint64_t u64()
+				{
+					uint64_t value = u32();
+					return (value << 32) | u32();
+				}
+
+				const uint8_t * bytes(std::size_t & length)
+				{
+					length = u8();
+
+					require(length);
+
+					const uint8_t * ptr = data + offset;
+					offset += length;
+
+					return ptr;
+				}
+
+				std::string string()
+				{
+					std::size_t length;
+					const uint8_t * ptr = bytes(length);
+
+					return std::string(reinterpret_cast<const char *>(ptr), length);
+				}
+
+				std::string longString()
+				{
+					std::size_t length = u16();
+
+					require(length);
+
+					const char * ptr = reinterpret_cast<const char *>(data + offset);
+					offset += length;
+
+					return std::string(ptr, length);
+				}
+
+				std::string token(const std::vector<std::string> & tokens)
+				{
+					uint8_t index = u8();
+
+					if (index == kCustomToken) {
+						return string();
+					}
+					if (index >= tokens.size()) {
+						throw Exception("Invalid encoded SDP token: %d", index);
+					}
+
+					return tokens[index];
+				}
+
+				bool done() const
+				{
+					return offset == size;
+				}
+
+			private:
+				void require(std::size_t count)
+				{
+					if (size - offset < count) {
+						throw Exception("Encoded SDP is truncated");
+					}
+				}
+
+			private:
+				const uint8_t * data;
+				const std::size_t size;
+				std::size_t offset;
+		};
+
+
+		static void writeAddress(Writer & writer, const webrtc::SocketAddress & address)
+		{
+			const webrtc::IPAddress & ip = address.ipaddr();
+
+			if (address.IsUnresolvedIP()) {
+				writer.u8(kHostname);
+				writer.string(address.hostname());
+			}
+			else if (ip.family() == AF_INET) {
+				in_addr addr = ip.ipv4_address();
+
+				writer.u8(kIPv4);
+				writer.data.insert(writer.data.end(), reinterpret_cast<const uint8_t *>(&addr), reinterpret_cast<const uint8_t *>(&addr) + 4);
+			}
+			else if (ip.family() == AF_INET6) {
+				in6_addr addr = ip.ipv6_address();
+
+				writer.u8(kIPv6);
+				writer.data.insert(writer.data.end(), reinterpret_cast<const uint8_t *>(&addr), reinterpret_cast<const uint8_t *>(&addr) + 16);
+			}
+			else {
+				throw Exception("Unsupported candidate address: %s", address.ToString().c_str());
+			}
+
+			writer.u16(address.port());
+		}
+
+		static webrtc::SocketAddress readAddress(Reader & reader)
+		{
+			uint8_t kind = reader.u8();
+			webrtc::SocketAddress address;
+
+			if (kind == kHostname) {
+				address.SetIP(reader.string());
+			}
+			else if (kind == kIPv4) {
+				in_addr addr;
+				uint8_t * bytes = reinterpret_cast<uint8_t *>(&addr);
+
+				for (int i = 0; i < 4; i++) {
+					bytes[i] = reader.u8();
+				}
+
+				address.SetIP(webrtc::IPAddress(addr));
+			}
+			else if (kind == kIPv6) {
+				in6_addr addr;
+				uint8_t * bytes = reinterpret_cast<uint8_t *>(&addr);
+
+				for (int i = 0; i < 16; i++) {
+					bytes[i] = reader.u8();
+				}
+
+				address.SetIP(webrtc::IPAddress(addr));
+			}
+			else {
+				throw Exception("Invalid encoded address kind: %d", kind);
+			}
+
+			address.SetPort(reader.u16());
+
+			return address;
+		}
+
+		static void writeCandidate(Writer & writer, const webrtc::Candidate & candidate)
+		{
+			writer.u8(static_cast<uint8_t>(candidate.component()));
+			writer.token(kProtocols, candidate.protocol());
+			writer.u8(static_cast<uint8_t>(candidate.type()));
+			writer.u32(candidate.priority());
+			writer.string(candidate.foundation());
+			writer.longString(candidate.username());
+			writeAddress(writer, candidate.address());
+
+			bool related = !candidate.related_address().IsNil();
+
+			writer.u8(related ? 1 : 0);
+
+			if (related) {
+				writeAddress(writer, candidate.related_address());
+			}
+
+			writer.token(kTcpTypes, candidate.tcptype());
+			writer.u32(candidate.generation());
+			writer.u16(candidate.network_id());
+			writer.u16(candidate.network_cost());
+		}
+
+		static webrtc::Candidate readCandidate(Reader & reader)
+		{
+			webrtc::Candidate candidate;
+
+			candidate.set_component(reader.u8());
+			candidate.set_protocol(reader.token(kProtocols));
+
+			uint8_t type = reader.u8();
+
+			if (type > static_cast<uint8_t>(webrtc::IceCandidateType::kRelay)) {
+				throw Exception("Invalid encoded candidate type: %d", type);
+			}
+
+			candidate.set_type(static_cast<webrtc::IceCandidateType>(type));
+			candidate.set_priority(reader.u32());
+			candidate.set_foundation(reader.string());
+			candidate.set_username(reader.longString());
+			candidate.set_address(readAddress(reader));
+
+			if (reader.u8() != 0) {
+				candidate.set_related_address(readAddress(reader));
+			}
+
+			candidate.set_tcptype(reader.token(kTcpTypes));
+			candidate.set_generation(reader.u32());
+			candidate.set_network_id(reader.u16());
+			candidate.set_network_cost(reader.u16());
+
+			return candidate;
+		}
+
+		static uint64_t parseNumber(const char * name, const std::string & value)
+		{
+			uint64_t number = 0;
+			const char * end = value.data() + value.size();
+
+			auto [ptr, ec] = std::from_chars(value.data(), end, number);
+
+			if (value.empty() || ec != std::errc() || ptr != end) {
+				throw Exception("Invalid %s: %s", name, value.c_str());
+			}
+
+			return number;
+		}
+
+		std::vector<uint8_t> encodeDescription(const webrtc::SessionDescriptionInterface & desc)
+		{
+			SdpTemplate::DataSession session;
+
+			if (!SdpTemplate::extract(desc, session)) {
+				throw Exception("Only single data channel sessions can be encoded");
+			}
+
+			uint8_t sdpType;
+
+			switch (session.type) {
+				case webrtc::SdpType::kOffer:
+					sdpType = 0;
+					break;
+				case webrtc::SdpType::kPrAnswer:
+					sdpType = 1;
+					break;
+				case webrtc::SdpType::kAnswer:
+					sdpType = 2;
+					break;
+				default:
+					throw Exception("Unsupported session description type");
+			}
+
+			uint8_t flags = 0;
+
+			if (session.iceLite) {
+				flags |= kIceLite;
+			}
+			if (session.trickle) {
+				flags |= kTrickle;
+			}
+			if (session.extmapAllowMixed) {
+				flags |= kExtmapAllowMixed;
+			}
+			if (session.msidSemantic) {
+				flags |= kMsidSemantic;
+			}
+
+			Writer writer;
+			writer.u8(kVersion);
+			writer.u8(sdpType);
+			writer.u64(parseNumber("session id", session.sessionId));
+			writer.u64(parseNumber("session version", session.sessionVersion));
+			writer.u8(flags);
+			writer.string(session.mid);
+			writer.longString(session.ufrag);
+			writer.longString(session.pwd);
+			writer.u8(static_cast<uint8_t>(session.role));
+			writer.token(kHashAlgorithms, session.fingerprint->algorithm);
+			writer.bytes(session.fingerprint->digest.cdata(), session.fingerprint->digest.size());
+			writer.u16(static_cast<uint16_t>(session.sctpPort));
+			writer.u32(static_cast<uint32_t>(session.maxMessageSize));
+
+			if (session.candidates.size() > 0xFFFF) {
+				throw Exception("Too many candidates to encode: %zu", session.candidates.size());
+			}
+
+			writer.u16(static_cast<uint16_t>(session.candidates.size()));
+
+			for (const webrtc::Candidate & candidate : session.candidates) {
+				writeCandidate(writer, candidate);
+			}
+
+			return writer.data;
+		}
+
+		std::unique_ptr<webrtc::SessionDescriptionInterface> decodeDescription(const uint8_t * data, std::size_t size)
+		{
+			Reader reader(data, size);
+
+			if (reader.u8() != kVersion) {
+				throw Exception("Unsupported encoded SDP version");
+			}
+
+			SdpTemplate::DataSession session;
+
+			uint8_t sdpType = reader.u8();
+
+			switch (sdpType) {
+				case 0:
+					session.type = webrtc::SdpType::kOffer;
+					break;
+				case 1:
+					session.type = webrtc::SdpType::kPrAnswer;
+					break;
+				case 2:
+					session.type = webrtc::SdpType::kAnswer;
+					break;
+				default:
+					throw Exception("Invalid encoded session description type: %d", sdpType);
+			}
+
+			session.sessionId = std::to_string(reader.u64());
+			session.sessionVersion = std::to_string(reader.u64());
+
+			uint8_t flags = reader.u8();
+
+			session.iceLite = (flags & kIceLite) != 0;
+			session.trickle = (flags & kTrickle) != 0;
+			session.extmapAllowMixed = (flags & kExtmapAllowMixed) != 0;
+			session.msidSemantic = (flags & kMsidSemantic) != 0;
+			session.mid = reader.string();
+			session.ufrag = reader.longString();
+			session.pwd = reader.longString();
+
+			uint8_t role = reader.u8();
+
+			if (role > webrtc::CONNECTIONROLE_HOLDCONN) {
+				throw Exception("Invalid encoded DTLS role: %d", role);
+			}
+
+			session.role = static_cast<webrtc::ConnectionRole>(role);
+
+			std::string algorithm = reader.token(kHashAlgorithms);
+			std::size_t digestSize;
+			const uint8_t * digest = reader.bytes(digestSize);
+
+			session.fingerprint = std::make_unique<webrtc::SSLFingerprint>(algorithm, webrtc::ArrayView<const uint8_t>(digest, digestSize));
+			session.sctpPort = reader.u16();
+			session.maxMessageSize = static_cast<int>(reader.u32());
+
+			uint16_t count = reader.u16();
+
+			session.candidates.reserve(count);
+
+			for (uint16_t i = 0; i < count; i++) {
+				session.candidates.push_back(readCandidate(reader));
+			}
+
+			if (!reader.done()) {
+				throw Exception("Encoded SDP has trailing data");
+			}
+
+			return SdpTemplate::create(session);
+		}
+
+		std::vector<uint8_t> encodeCandidates(const std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> & candidates)
+		{
+			if (candidates.size() > 0xFFFF) {
+				throw Exception("Too many candidates to encode: %zu", candidates.size());
+			}
+
+			Writer writer;
+			writer.u8(kVersion);
+			writer.u16(static_cast<uint16_t>(candidates.size()));
+
+			for (const auto & candidate : candidates) {
+				writer.string(candidate->sdp_mid());
+				writer.u16(static_cast<uint16_t>(candidate->sdp_mline_index()));
+				writeCandidate(writer, candidate->candidate());
+			}
+
+			return writer.data;
+		}
+
+		std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> decodeCandidates(const uint8_t * data, std::size_t size)
+		{
+			Reader reader(data, size);
+
+			if (reader.u8() != kVersion) {
+				throw Exception("Unsupported encoded candidate version");
+			}
+
+			uint16_t count = reader.u16();
+
+			std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> candidates;
+			candidates.reserve(count);
+
+			for (uint16_t i = 0; i < count; i++) {
+				std::string mid = reader.string();
+				int mlineIndex = reader.u16();
+
+				candidates.push_back(webrtc::CreateIceCandidate(mid, mlineIndex, readCandidate(reader)));
+			}
+
+			if (!reader.done()) {
+				throw Exception("Encoded candidates have trailing data");
+			}
+
+			return candidates;
+		}
+	}
+}
@@ -0,0 +1,461 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "api/SdpTemplate.h"
+
+#include "p2p/base/p2p_constants.h"
+#include "p2p/base/transport_info.h"
+#include "pc/session_description.h"
+#include "pc/webrtc_sdp.h"
+#include "rtc_base/ip_address.h"
+
+#include <charconv>
+
+namespace jni
+{
+	namespace SdpTemplate
+	{
+		static constexpr char kBundleGroup[] = "BUNDLE";
+		static constexpr char kSctpProtocol[] = "UDP/DTLS/SCTP";
+		static constexpr char kTrickleOption[] = "trickle";
+
+		static bool consume(std::string_view & line, std::string_view prefix)
+		{
+			if (line.substr(0, prefix.size()) != prefix) {
+				return false;
+			}
+
+			line.remove_prefix(prefix.size());
+
+			return true;
+		}
+
+		static bool toInt(std::string_view value, int & result)
+		{
+			auto end = value.data() + value.size();
+			auto [ptr, ec] = std::from_chars(value.data(), end, result);
+
+			return ec == std::errc() && ptr == end;
+		}
+
+		static std::string_view nextToken(std::string_view & value)
+		{
+			std::size_t pos = value.find(' ');
+			std::string_view token = value.substr(0, pos);
+
+			value = (pos == std::string_view::npos) ? std::string_view() : value.substr(pos + 1);
+
+			return token;
+		}
+
+		static bool matchOrigin(std::string_view line, DataSession & session)
+		{
+			// o=<username> <sess-id> <sess-version> IN <addrtype> <address>
+			nextToken(line);
+
+			std::string_view id = nextToken(line);
+			std::string_view version = nextToken(line);
+
+			if (id.empty() || version.empty() || nextToken(line) != "IN") {
+				return false;
+			}
+
+			session.sessionId = std::string(id);
+			session.sessionVersion = std::string(version);
+
+			return true;
+		}
+
+		static bool matchMediaLine(std::string_view line)
+		{
+			// m=application <port> UDP/DTLS/SCTP webrtc-datachannel
+			if (!consume(line, "application ")) {
+				return false;
+			}
+
+			int port;
+
+			if (!toInt(nextToken(line), port)) {
+				return false;
+			}
+
+			return nextToken(line) == kSctpProtocol && line == "webrtc-datachannel";
+		}
+
+		bool extract(const webrtc::SessionDescriptionInterface & desc, DataSession & session)
+		{
+			const webrtc::SessionDescription * description = desc.description();
+
+			if (description == nullptr || description->contents().size() != 1 || description->groups().size() != 1) {
+				return false;
+			}
+			if (desc.GetType() == webrtc::SdpType::kRollback) {
+				return false;
+			}
+
+			const webrtc::ContentInfo & content = description->contents()[0];
+			const webrtc::MediaContentDescription * media = content.media_description();
+
+			if (content.type != webrtc::MediaProtocolType::kSctp || content.rejected || content.bundle_only) {
+				return false;
+			}
+			if (media == nullptr || media->as_sctp() == nullptr || media->protocol() != kSctpProtocol) {
+				return false;
+			}
+
+			const webrtc::ContentGroup * bundle = description->GetGroupByName(kBundleGroup);
+
+			if (bundle == nullptr || bundle->content_names().size() != 1 || bundle->content_names()[0] != content.mid()) {
+				return false;
+			}
+
+			const webrtc::TransportInfo * transportInfo = description->GetTransportInfoByName(content.mid());
+
+			if (transportInfo == nullptr || !transportInfo->description.identity_fingerprint) {
+				return false;
+			}
+
+			const webrtc::TransportDescription & transport = transportInfo->description;
+			const std::vector<std::string> & options = transport.transport_options;
+
+			if (options.size() > 1 || (options.size() == 1 && options[0] != kTrickleOption)) {
+				return false;
+			}
+
+			session.type = desc.GetType();
+			session.sessionId = desc.session_id();
+			session.sessionVersion = desc.session_version();
+			session.extmapAllowMixed = description->extmap_allow_mixed();
+			session.msidSemantic = (description->msid_signaling() & webrtc::kMsidSignalingSemantic) != 0;
+			session.iceLite = transport.ice_mode == webrtc::ICEMODE_LITE;
+			session.trickle = !options.empty();
+			session.mid = content.mid();
+			session.ufrag = transport.ice_ufrag;
+			session.pwd = transport.ice_pwd;
+			session.role = transport.connection_role;
+			session.fingerprint = std::make_unique<webrtc::SSLFingerprint>(*transport.identity_fingerprint);
+			session.sctpPort = media->as_sctp()->port();
+			session.maxMessageSize = media->as_sctp()->max_message_size();
+			session.candidates.clear();
+
+			const webrtc::IceCandidateCollection * candidates = desc.candidates(0);
+
+			if (candidates != nullptr) {
+				session.candidates.reserve(candidates->count());
+
+				for (std::size_t i = 0; i < candidates->count(); i++) {
+					session.candidates.push_back(candidates->at(i)->candidate());
+				}
+			}
+
+			return true;
+		}
+
+		bool match(webrtc::SdpType type, std::string_view sdp, DataSession & session)
+		{
+			std::vector<std::string_view> candidateLines;
+			std::string_view bundleMid;
+			bool hasVersion = false;
+			bool hasOrigin = false;
+			bool hasMedia = false;
+			bool hasSctpPort = false;
+			bool hasMaxMessageSize = false;
+
+			while (!sdp.empty()) {
+				std::size_t end = sdp.find('\n');
+				std::string_view line = sdp.substr(0, end);
+
+				sdp = (end == std::string_view::npos) ? std::string_view() : sdp.substr(end + 1);
+
+				if (!line.empty() && line.back() == '\r') {
+					line.remove_suffix(1);
+				}
+
+				if (!hasMedia) {
+					if (line == "v=0") {
+						hasVersion = true;
+					}
+					else if (consume(line, "o=")) {
+						if (!matchOrigin(line, session)) {
+							return false;
+						}
+
+						hasOrigin = true;
+					}
+					else if (consume(line, "a=group:BUNDLE ")) {
+						if (!bundleMid.empty() || line.empty() || line.find(' ') != std::string_view::npos) {
+							return false;
+						}
+
+						bundleMid = line;
+					}
+					else if (line == "a=ice-lite") {
+						session.iceLite = true;
+					}
+					else if (consume(line, "m=")) {
+						if (!matchMediaLine(line)) {
+							return false;
+						}
+
+						hasMedia = true;
+					}
+					else if (line == "a=extmap-allow-mixed") {
+						session.extmapAllowMixed = true;
+					}
+					else if (line == "a=msid-semantic: WMS") {
+						// Data channels have no media streams to list.
+						session.msidSemantic = true;
+					}
+					else if (line.substr(0, 2) != "s=" && line.substr(0, 2) != "t=") {
+						return false;
+					}
+				}
+				else if (line.substr(0, 12) == "a=candidate:") {
+					candidateLines.push_back(line);
+				}
+				else if (consume(line, "a=ice-ufrag:")) {
+					session.ufrag = std::string(line);
+				}
+				else if (consume(line, "a=ice-pwd:")) {
+					session.pwd = std::string(line);
+				}
+				else if (consume(line, "a=ice-options:")) {
+					if (line != kTrickleOption) {
+						return false;
+					}
+
+					session.trickle = true;
+				}
+				else if (consume(line, "a=fingerprint:")) {
+					std::string_view algorithm = nextToken(line);
+
+					session.fingerprint = webrtc::SSLFingerprint::CreateUniqueFromRfc4572(algorithm, line);
+
+					if (!session.fingerprint) {
+						return false;
+					}
+				}
+				else if (consume(line, "a=setup:")) {
+					if (!webrtc::StringToConnectionRole(line, &session.role)) {
+						return false;
+					}
+				}
+				else if (consume(line, "a=mid:")) {
+					session.mid = std::string(line);
+				}
+				else if (consume(line, "a=sctp-port:")) {
+					hasSctpPort = toInt(line, session.sctpPort);
+				}
+				else if (consume(line, "a=max-message-size:")) {
+					hasMaxMessageSize = toInt(line, session.maxMessageSize);
+				}
+				else if (line.substr(0, 2) != "c=" && line != "a=end-of-candidates") {
+					return false;
+				}
+			}
+
+			if (!hasVersion || !hasOrigin || !hasMedia || !hasSctpPort || !hasMaxMessageSize) {
+				return false;
+			}
+			if (session.mid.empty() || session.mid != bundleMid || session.ufrag.empty() || session.pwd.empty() || !session.fingerprint) {
+				return false;
+			}
+
+			session.type = type;
+			session.candidates.clear();
+			session.candidates.reserve(candidateLines.size());
+
+			for (std::string_view line : candidateLines) {
+				webrtc::Candidate candidate;
+				webrtc::SdpParseError error;
+
+				if (!webrtc::SdpDeserializeCandidate(session.mid, line, &candidate, &error)) {
+					return false;
+				}
+
+				session.candidates.push_back(std::move(candidate));
+			}
+
+			return true;
+		}
+
+		/*
+		 * Writes the address of the default candidate of the m-line, selected
+		 * like the generic serializer does: UDP candidates of the first
+		 * component, relayed before reflexive before host, IPv4 before IPv6.
+		 */
+		static void appendDefaultDestination(std::string & sdp, const std::vector<webrtc::Candidate> & candidates)
+		{
+			const webrtc::Candidate * destination = nullptr;
+			int destinationPreference = 0;
+			int destinationFamily = AF_UNSPEC;
+
+			for (const webrtc::Candidate & candidate : candidates) {
+				if (candidate.component() != webrtc::ICE_CANDIDATE_COMPONENT_RTP || candidate.protocol() != "udp") {
+					continue;
+				}
+
+				// Unresolved mDNS hostnames have no address family.
+				const int family = candidate.address().ipaddr().family();
+				int preference = 0;
+
+				if (candidate.is_relay()) {
+					preference = 3;
+				}
+				else if (candidate.is_stun()) {
+					preference = 2;
+				}
+				else if (candidate.is_local()) {
+					preference = 1;
+				}
+
+				if (family != AF_INET && family != AF_INET6) {
+					continue;
+				}
+				if ((preference <= destinationPreference && family == destinationFamily) || (destinationFamily == AF_INET && family == AF_INET6)) {
+					continue;
+				}
+
+				destination = &candidate;
+				destinationPreference = preference;
+				destinationFamily = family;
+			}
+
+			if (destination == nullptr) {
+				sdp += "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n";
+				sdp += "c=IN IP4 0.0.0.0\r\n";
+				return;
+			}
+
+			const webrtc::SocketAddress & address = destination->address();
+
+			sdp += "m=application " + address.PortAsString() + " UDP/DTLS/SCTP webrtc-datachannel\r\n";
+			sdp += (destinationFamily == AF_INET6 ? "c=IN IP6 " : "c=IN IP4 ") + address.ipaddr().ToString() + "\r\n";
+		}
+
+		std::string build(const DataSession & session)
+		{
+			std::string sdp;
+			sdp.reserve(512 + session.candidates.size() * 128);
+
+			sdp += "v=0\r\n";
+			sdp += "o=- " + session.sessionId + " " + session.sessionVersion + " IN IP4 127.0.0.1\r\n";
+			sdp += "s=-\r\n";
+			sdp += "t=0 0\r\n";
+			sdp += "a=group:BUNDLE " + session.mid + "\r\n";
+
+			if (session.extmapAllowMixed) {
+				sdp += "a=extmap-allow-mixed\r\n";
+			}
+			if (session.msidSemantic) {
+				sdp += "a=msid-semantic: WMS\r\n";
+			}
+			if (session.iceLite) {
+				sdp += "a=ice-lite\r\n";
+			}
+
+			appendDefaultDestination(sdp, session.candidates);
+
+			for (const webrtc::Candidate & candidate : session.candidates) {
+				sdp += "a=" + webrtc::SdpSerializeCandidate(candidate) + "\r\n";
+			}
+
+			sdp += "a=ice-ufrag:" + session.ufrag + "\r\n";
+			sdp += "a=ice-pwd:" + session.pwd + "\r\n";
+
+			if (session.trickle) {
+				sdp += "a=ice-options:trickle\r\n";
+			}
+
+			sdp += "a=fingerprint:" + session.fingerprint->algorithm + " " + session.fingerprint->GetRfc4572Fingerprint() + "\r\n";
+
+			std::string role;
+
+			if (webrtc::ConnectionRoleToString(session.role, &role)) {
+				sdp += "a=setup:" + role + "\r\n";
+			}
+
+			sdp += "a=mid:" + session.mid + "\r\n";
+			sdp += "a=sctp-port:" + std::to_string(session.sctpPort) + "\r\n";
+			sdp += "a=max-message-size:" + std::to_string(session.maxMessageSize) + "\r\n";
+
+			return sdp;
+		}
+
+		std::unique_ptr<webrtc::SessionDescriptionInterface> create(const DataSession & session)
+		{
+			auto sctp = std::make_unique<webrtc::SctpDataContentDescription>();
+			sctp->set_protocol(kSctpProtocol);
+			sctp->set_use_sctpmap(false);
+			sctp->set_port(session.sctpPort);
+			sctp->set_max_message_size(session.maxMessageSize);
+
+			std::vector<std::string> options;
+
+			if (session.trickle) {
+				options.emplace_back(kTrickleOption);
+			}
+
+			webrtc::TransportDescription transport(options, session.ufrag, session.pwd,
+				session.iceLite ? webrtc::ICEMODE_LITE : webrtc::ICEMODE_FULL, session.role, session.fingerprint.get());
+
+			webrtc::ContentGroup bundle(kBundleGroup);
+			bundle.AddContentName(session.mid);
+
+			auto description = std::make_unique<webrtc::SessionDescription>();
+			description->AddContent(session.mid, webrtc::MediaProtocolType::kSctp, std::move(sctp));
+			description->AddTransportInfo(webrtc::TransportInfo(session.mid, transport));
+			description->AddGroup(bundle);
+			description->set_extmap_allow_mixed(session.extmapAllowMixed);
+			description->set_msid_signaling(session.msidSemantic ? webrtc::kMsidSignalingSemantic : webrtc::kMsidSignalingNotUsed);
+
+			auto desc = webrtc::CreateSessionDescription(session.type, session.sessionId, session.sessionVersion, std::move(description));
+
+			for (const webrtc::Candidate & candidate : session.candidates) {
+				auto iceCandidate = webrtc::CreateIceCandidate(session.mid, 0, candidate);
+
+				desc->AddCandidate(iceCandidate.get());
+			}
+
+			return desc;
+		}
+
+		std::string serialize(const webrtc::SessionDescriptionInterface & desc, bool enabled)
+		{
+			DataSession session;
+
+			if (enabled && extract(desc, session)) {
+				return build(session);
+			}
+
+			std::string sdp;
+			desc.ToString(&sdp);
+
+			return sdp;
+		}
+
+		std::unique_ptr<webrtc::SessionDescriptionInterface> deserialize(webrtc::SdpType type, const std::string & sdp, webrtc::SdpParseError * error, bool enabled)
+		{
+			DataSession session;
+
+			if (enabled && match(type, sdp, session)) {
+				return create(session);
+			}
+
+			return webrtc::CreateSessionDescription(type, sdp, error);
+		}
+	}
+}
@@ -16,6 +16,10 @@
 
 #include "api/WebRTCUtils.h"
 
+#include "p2p/base/transport_description.h"
+#include "p2p/base/transport_info.h"
+#include "pc/session_description.h"
+
 namespace jni
 {
 	std::string RTCErrorToString(const webrtc::RTCError & error)
@@ -25,4 +29,15 @@ namespace jni
 
 		return "[" + type + "] " + message;
 	}
+
+	void SetIceLiteMode(webrtc::SessionDescriptionInterface * desc)
+	{
+		if (desc->description() == nullptr) {
+			return;
+		}
+
+		for (auto & transportInfo : desc->description()->transport_infos()) {
+			transportInfo.description.ice_mode = webrtc::ICEMODE_LITE;
+		}
+	}
 }
\ No newline at end of file
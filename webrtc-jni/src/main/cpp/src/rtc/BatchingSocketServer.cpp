@@ -0,0 +1,494 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rtc/BatchingSocketServer.h"
+
+#if defined(WEBRTC_LINUX)
+
+#include "rtc_base/logging.h"
+#include "rtc_base/thread.h"
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace jni
+{
+	// Kernel limits of a single GSO send.
+	static constexpr std::size_t kMaxSegments = 64;
+	static constexpr std::size_t kMaxSegmentBytes = 65000;
+
+	BatchingSocketDispatcher::BatchingSocketDispatcher(BatchingSocketServer * server) :
+		webrtc::SocketDispatcher(server),
+		server(server),
+		gro(false),
+		gso(false),
+		segmentSize(0),
+		segmentCount(0),
+		segmentAddress(),
+		segmentAddressLength(0),
+		segmentsClosed(false),
+		flushScheduled(false),
+		blocked(false),
+		sendError(0),
+		alive(std::make_shared<bool>(true))
+	{
+	}
+
+	BatchingSocketDispatcher::~BatchingSocketDispatcher()
+	{
+		*alive = false;
+	}
+
+	bool BatchingSocketDispatcher::Create(int family, int type)
+	{
+		if (!webrtc::SocketDispatcher::Create(family, type)) {
+			return false;
+		}
+
+		if (type == SOCK_DGRAM && server->udpOffload) {
+			// Probe offload support, older kernels reject the options.
+			int enable = 1;
+			gro = setsockopt(s_, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == 0;
+
+			int segment = 0;
+			socklen_t length = sizeof(segment);
+			gso = getsockopt(s_, SOL_UDP, UDP_SEGMENT, &segment, &length) == 0;
+
+			if (!gro || !gso) {
+				RTC_LOG(LS_VERBOSE) << "UDP offload not fully supported, GRO: " << gro << ", GSO: " << gso;
+			}
+		}
+
+		return true;
+	}
+
+	int BatchingSocketDispatcher::RecvFrom(void * buffer, size_t length, webrtc::SocketAddress * address, int64_t * timestamp)
+	{
+		if (!udp_ || (queue.empty() && !fillQueue())) {
+			return webrtc::SocketDispatcher::RecvFrom(buffer, length, address, timestamp);
+		}
+
+		Datagram & datagram = queue.front();
+		size_t size = std::min(length, datagram.data.size());
+
+		std::memcpy(buffer, datagram.data.data(), size);
+
+		if (address) {
+			*address = datagram.address;
+		}
+		if (timestamp) {
+			*timestamp = -1;
+		}
+
+		queue.pop_front();
+
+		EnableEvents(webrtc::DE_READ);
+
+		return static_cast<int>(size);
+	}
+
+	int BatchingSocketDispatcher::RecvFrom(ReceiveBuffer & buffer)
+	{
+		if (!udp_ || (queue.empty() && !fillQueue())) {
+			return webrtc::SocketDispatcher::RecvFrom(buffer);
+		}
+
+		Datagram & datagram = queue.front();
+
+		buffer.payload = std::move(datagram.data);
+		buffer.source_address = datagram.address;
+
+		queue.pop_front();
+
+		EnableEvents(webrtc::DE_READ);
+
+		return static_cast<int>(buffer.payload.size());
+	}
+
+	void BatchingSocketDispatcher::OnEvent(uint32_t ff, int err)
+	{
+		std::shared_ptr<bool> guard = alive;
+
+		if ((ff & webrtc::DE_WRITE) && blocked && !flushSegments()) {
+			// Still not writable, keep the senders waiting.
+			ff &= ~webrtc::DE_WRITE;
+		}
+
+		webrtc::SocketDispatcher::OnEvent(ff, err);
+
+		// Deliver the datagrams fetched by the batched read without waiting
+		// for the next poll. Stop if the handler does not consume them.
+		while (*guard && (ff & webrtc::DE_READ) && !queue.empty()) {
+			size_t pending = queue.size();
+
+			SignalReadEvent(this);
+
+			if (!*guard || queue.size() >= pending) {
+				break;
+			}
+		}
+	}
+
+	int BatchingSocketDispatcher::Close()
+	{
+		flushSegments();
+
+		// Drop a batch the socket did not take.
+		segments.clear();
+		segmentCount = 0;
+		blocked = false;
+		sendError = 0;
+
+		queue.clear();
+
+		return webrtc::SocketDispatcher::Close();
+	}
+
+	int BatchingSocketDispatcher::DoSendTo(int socket, const char * buf, int len, int flags, const struct sockaddr * dest_addr, socklen_t addrlen)
+	{
+		if (blocked) {
+			// Let the caller wait for the write event, like a regular socket.
+			errno = EWOULDBLOCK;
+			return -1;
+		}
+		if (sendError != 0) {
+			errno = std::exchange(sendError, 0);
+			return -1;
+		}
+
+		if (!gso || len <= 0 || dest_addr == nullptr) {
+			return webrtc::SocketDispatcher::DoSendTo(socket, buf, len, flags, dest_addr, addrlen);
+		}
+
+		const size_t size = static_cast<size_t>(len);
+
+		if (!appendSegment(buf, size, dest_addr, addrlen)) {
+			if (!flushSegments()) {
+				errno = EWOULDBLOCK;
+				return -1;
+			}
+
+			if (!appendSegment(buf, size, dest_addr, addrlen)) {
+				return webrtc::SocketDispatcher::DoSendTo(socket, buf, len, flags, dest_addr, addrlen);
+			}
+		}
+
+		if (!flushScheduled) {
+			webrtc::Thread * thread = webrtc::Thread::Current();
+
+			if (thread == nullptr) {
+				if (flushSegments() && sendError != 0) {
+					errno = std::exchange(sendError, 0);
+					return -1;
+				}
+				return len;
+			}
+
+			// Coalesce everything sent within the current network thread task.
+			flushScheduled = true;
+
+			thread->PostTask(webrtc::SafeTask(safety.flag(), [this]() {
+				flushScheduled = false;
+				flushSegments();
+			}));
+		}
+
+		return len;
+	}
+
+	bool BatchingSocketDispatcher::fillQueue()
+	{
+		mmsghdr * messages = server->messages.data();
+
+		for (std::size_t i = 0; i < BatchingSocketServer::kBatchSize; i++) {
+			msghdr & header = messages[i].msg_hdr;
+			header.msg_namelen = sizeof(sockaddr_storage);
+			header.msg_control = gro ? server->controls.data() + i * BatchingSocketServer::kControlSize : nullptr;
+			header.msg_controllen = gro ? BatchingSocketServer::kControlSize : 0;
+			header.msg_flags = 0;
+
+			messages[i].msg_len = 0;
+		}
+
+		int count = recvmmsg(s_, messages, BatchingSocketServer::kBatchSize, MSG_DONTWAIT, nullptr);
+
+		if (count <= 0) {
+			return false;
+		}
+
+		for (int i = 0; i < count; i++) {
+			msghdr & header = messages[i].msg_hdr;
+
+			if (header.msg_flags & MSG_TRUNC) {
+				continue;
+			}
+
+			int segment = 0;
+
+			if (gro) {
+				for (cmsghdr * cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+					if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+						std::memcpy(&segment, CMSG_DATA(cmsg), sizeof(segment));
+					}
+				}
+			}
+
+			enqueue(static_cast<const uint8_t *>(header.msg_iov->iov_base), messages[i].msg_len, segment, server->addresses[i]);
+		}
+
+		return !queue.empty();
+	}
+
+	void BatchingSocketDispatcher::enqueue(const uint8_t * data, size_t size, int segmentSize, const sockaddr_storage & address)
+	{
+		webrtc::SocketAddress source;
+		webrtc::SocketAddressFromSockAddrStorage(address, &source);
+
+		// A GRO buffer contains equally sized segments, only the last one may
+		// be shorter.
+		size_t step = segmentSize > 0 ? static_cast<size_t>(segmentSize) : size;
+
+		for (size_t offset = 0; offset < size; offset += step) {
+			Datagram datagram;
+			datagram.data.SetData(data + offset, std::min(step, size - offset));
+			datagram.address = source;
+
+			queue.push_back(std::move(datagram));
+		}
+	}
+
+	bool BatchingSocketDispatcher::appendSegment(const char * buf, size_t len, const struct sockaddr * address, socklen_t addressLength)
+	{
+		if (segmentCount == 0) {
+			if (len > kMaxSegmentBytes || addressLength > sizeof(segmentAddress)) {
+				return false;
+			}
+
+			std::memcpy(&segmentAddress, address, addressLength);
+			segmentAddressLength = addressLength;
+			segmentSize = len;
+			segmentsClosed = false;
+		}
+		else {
+			if (segmentsClosed || len > segmentSize) {
+				return false;
+			}
+			if (segmentCount >= kMaxSegments || segments.size() + len > kMaxSegmentBytes) {
+				return false;
+			}
+			if (addressLength != segmentAddressLength || std::memcmp(&segmentAddress, address, addressLength) != 0) {
+				return false;
+			}
+
+			// A shorter segment terminates the batch.
+			segmentsClosed = len < segmentSize;
+		}
+
+		segments.insert(segments.end(), buf, buf + len);
+		segmentCount++;
+
+		return true;
+	}
+
+	bool BatchingSocketDispatcher::flushSegments()
+	{
+		if (segmentCount == 0) {
+			return true;
+		}
+
+		const sockaddr * address = reinterpret_cast<const sockaddr *>(&segmentAddress);
+		const char * data = reinterpret_cast<const char *>(segments.data());
+
+		int error = 0;
+
+		if (segmentCount == 1) {
+			if (webrtc::SocketDispatcher::DoSendTo(s_, data, static_cast<int>(segments.size()), MSG_NOSIGNAL, address, segmentAddressLength) < 0) {
+				error = errno;
+			}
+		}
+		else {
+			iovec vector;
+			vector.iov_base = segments.data();
+			vector.iov_len = segments.size();
+
+			char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+
+			msghdr header = {};
+			header.msg_name = &segmentAddress;
+			header.msg_namelen = segmentAddressLength;
+			header.msg_iov = &vector;
+			header.msg_iovlen = 1;
+			header.msg_control = control;
+			header.msg_controllen = sizeof(control);
+
+			cmsghdr * cmsg = CMSG_FIRSTHDR(&header);
+			cmsg->cmsg_level = SOL_UDP;
+			cmsg->cmsg_type = UDP_SEGMENT;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+
+			uint16_t gsoSize = static_cast<uint16_t>(segmentSize);
+			std::memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+
+			if (sendmsg(s_, &header, MSG_NOSIGNAL) >= 0) {
+				server->offloadedDatagrams.fetch_add(segmentCount, std::memory_order_relaxed);
+			}
+			else if (errno == EIO) {
+				// The route or device does not support segmentation offload.
+				RTC_LOG(LS_WARNING) << "UDP GSO send failed, falling back to single datagrams";
+
+				gso = false;
+
+				for (size_t offset = 0; offset < segments.size(); offset += segmentSize) {
+					size_t length = std::min(segmentSize, segments.size() - offset);
+
+					if (webrtc::SocketDispatcher::DoSendTo(s_, data + offset, static_cast<int>(length), MSG_NOSIGNAL, address, segmentAddressLength) < 0) {
+						error = errno;
+					}
+				}
+			}
+			else {
+				error = errno;
+			}
+		}
+
+		if (error == EAGAIN || error == EWOULDBLOCK) {
+			// Keep the batch and retry once the socket is writable.
+			blocked = true;
+			segmentsClosed = true;
+
+			EnableEvents(webrtc::DE_WRITE);
+
+			return false;
+		}
+		if (error != 0) {
+			RTC_LOG(LS_WARNING) << "UDP batch send failed: " << std::strerror(error);
+
+			sendError = error;
+		}
+
+		segments.clear();
+		segmentCount = 0;
+		segmentsClosed = false;
+		blocked = false;
+
+		return true;
+	}
+
+	BatchingSocketServer::BatchingSocketServer(bool udpOffload) :
+		udpOffload(udpOffload),
+		buffers(kBatchSize * kMaxDatagramSize),
+		controls(kBatchSize * kControlSize),
+		messages(kBatchSize),
+		vectors(kBatchSize),
+		addresses(kBatchSize)
+	{
+		for (std::size_t i = 0; i < kBatchSize; i++) {
+			vectors[i].iov_base = buffers.data() + i * kMaxDatagramSize;
+			vectors[i].iov_len = kMaxDatagramSize;
+
+			std::memset(&messages[i], 0, sizeof(mmsghdr));
+
+			messages[i].msg_hdr.msg_name = &addresses[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+			messages[i].msg_hdr.msg_iov = &vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+	}
+
+	uint64_t BatchingSocketServer::getOffloadedDatagrams() const
+	{
+		return offloadedDatagrams.load(std::memory_order_relaxed);
+	}
+
+	bool BatchingSocketServer::isUdpOffloadSupported()
+	{
+		int s = socket(AF_INET, SOCK_DGRAM, 0);
+
+		if (s < 0) {
+			return false;
+		}
+
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		socklen_t addressLength = sizeof(address);
+
+		bool supported = bind(s, reinterpret_cast<sockaddr *>(&address), addressLength) == 0 &&
+			getsockname(s, reinterpret_cast<sockaddr *>(&address), &addressLength) == 0;
+
+		if (supported) {
+			// Two segments sent to the socket itself.
+			uint8_t payload[2 * 100] = {};
+			iovec vector = { payload, sizeof(payload) };
+
+			char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+
+			msghdr header = {};
+			header.msg_name = &address;
+			header.msg_namelen = addressLength;
+			header.msg_iov = &vector;
+			header.msg_iovlen = 1;
+			header.msg_control = control;
+			header.msg_controllen = sizeof(control);
+
+			cmsghdr * cmsg = CMSG_FIRSTHDR(&header);
+			cmsg->cmsg_level = SOL_UDP;
+			cmsg->cmsg_type = UDP_SEGMENT;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+
+			uint16_t gsoSize = sizeof(payload) / 2;
+			std::memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+
+			supported = sendmsg(s, &header, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(payload));
+		}
+
+		close(s);
+
+		return supported;
+	}
+
+	webrtc::Socket * BatchingSocketServer::CreateSocket(int family, int type)
+	{
+		BatchingSocketDispatcher * dispatcher = new BatchingSocketDispatcher(this);
+
+		if (dispatcher->Create(family, type)) {
+			return dispatcher;
+		}
+
+		delete dispatcher;
+
+		return nullptr;
+	}
+}
+
+#endif
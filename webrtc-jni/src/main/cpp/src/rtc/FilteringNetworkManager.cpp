@@ -0,0 +1,232 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rtc/FilteringNetworkManager.h"
+#include "Exception.h"
+
+#include <map>
+
+namespace jni
+{
+	static constexpr int kCellularAdapterTypes = webrtc::ADAPTER_TYPE_CELLULAR
+		| webrtc::ADAPTER_TYPE_CELLULAR_2G
+		| webrtc::ADAPTER_TYPE_CELLULAR_3G
+		| webrtc::ADAPTER_TYPE_CELLULAR_4G
+		| webrtc::ADAPTER_TYPE_CELLULAR_5G;
+
+	FilteringNetworkManager::FilteringNetworkManager(webrtc::NetworkManager * networkManager, const NetworkFilter & filter) :
+		networkManager(networkManager),
+		ignoreMask(filter.ignoreMask),
+		disableIpv6(filter.disableIpv6),
+		maxNetworksPerInterface(filter.maxNetworksPerInterface),
+		startCount(0)
+	{
+		for (const auto & entry : filter.allowList) {
+			allowList.push_back(parse(entry));
+		}
+		for (const auto & entry : filter.denyList) {
+			denyList.push_back(parse(entry));
+		}
+	}
+
+	void FilteringNetworkManager::validate(const NetworkFilter & filter)
+	{
+		for (const auto & entry : filter.allowList) {
+			parse(entry);
+		}
+		for (const auto & entry : filter.denyList) {
+			parse(entry);
+		}
+	}
+
+	void FilteringNetworkManager::StartUpdating()
+	{
+		if (startCount++ == 0) {
+			networkManager->SignalNetworksChanged.connect(this, &FilteringNetworkManager::onNetworksChanged);
+		}
+
+		// Re-signals an already enumerated network list asynchronously.
+		networkManager->StartUpdating();
+	}
+
+	void FilteringNetworkManager::StopUpdating()
+	{
+		if (startCount == 0) {
+			return;
+		}
+
+		networkManager->StopUpdating();
+
+		if (--startCount == 0) {
+			networkManager->SignalNetworksChanged.disconnect(this);
+		}
+	}
+
+	std::vector<const webrtc::Network *> FilteringNetworkManager::GetNetworks() const
+	{
+		return filter(networkManager->GetNetworks());
+	}
+
+	std::vector<const webrtc::Network *> FilteringNetworkManager::GetAnyAddressNetworks()
+	{
+		return networkManager->GetAnyAddressNetworks();
+	}
+
+	webrtc::MdnsResponderInterface * FilteringNetworkManager::GetMdnsResponder() const
+	{
+		return networkManager->GetMdnsResponder();
+	}
+
+	webrtc::NetworkManager::EnumerationPermission FilteringNetworkManager::enumeration_permission() const
+	{
+		return networkManager->enumeration_permission();
+	}
+
+	bool FilteringNetworkManager::GetDefaultLocalAddress(int family, webrtc::IPAddress * ipaddr) const
+	{
+		return networkManager->GetDefaultLocalAddress(family, ipaddr);
+	}
+
+	FilteringNetworkManager::Matcher FilteringNetworkManager::parse(const std::string & entry)
+	{
+		Matcher matcher;
+
+		size_t separator = entry.find('/');
+
+		if (separator == std::string::npos) {
+			if (entry.empty()) {
+				throw Exception("Empty network interface entry");
+			}
+
+			matcher.wildcard = entry.back() == '*';
+			matcher.name = matcher.wildcard ? entry.substr(0, entry.size() - 1) : entry;
+
+			return matcher;
+		}
+
+		std::string address = entry.substr(0, separator);
+		std::string length = entry.substr(separator + 1);
+
+		if (!webrtc::IPFromString(address, &matcher.prefix)) {
+			throw Exception("Invalid network address: %s", entry.c_str());
+		}
+
+		const int maxLength = matcher.prefix.family() == AF_INET6 ? 128 : 32;
+
+		try {
+			size_t parsed = 0;
+			matcher.prefixLength = std::stoi(length, &parsed);
+
+			if (parsed != length.size()) {
+				matcher.prefixLength = -1;
+			}
+		}
+		catch (...) {
+			matcher.prefixLength = -1;
+		}
+
+		if (matcher.prefixLength < 0 || matcher.prefixLength > maxLength) {
+			throw Exception("Invalid network prefix length: %s", entry.c_str());
+		}
+
+		matcher.prefix = webrtc::TruncateIP(matcher.prefix, matcher.prefixLength);
+
+		return matcher;
+	}
+
+	bool FilteringNetworkManager::Matcher::matches(const webrtc::Network * network) const
+	{
+		if (prefixLength < 0) {
+			if (wildcard) {
+				return network->name().compare(0, name.size(), name) == 0;
+			}
+
+			return network->name() == name;
+		}
+
+		for (const auto & ip : network->GetIPs()) {
+			if (ip.family() == prefix.family() && webrtc::TruncateIP(ip, prefixLength) == prefix) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	std::vector<const webrtc::Network *> FilteringNetworkManager::filter(const std::vector<const webrtc::Network *> & networks) const
+	{
+		std::vector<const webrtc::Network *> filtered;
+		std::map<std::string, int> interfaceCount;
+
+		// Networks are ordered by preference, so the limit keeps the best ones.
+		for (const webrtc::Network * network : networks) {
+			if (!isAllowed(network)) {
+				continue;
+			}
+			if (maxNetworksPerInterface > 0 && interfaceCount[network->name()]++ >= maxNetworksPerInterface) {
+				continue;
+			}
+
+			filtered.push_back(network);
+		}
+
+		return filtered;
+	}
+
+	bool FilteringNetworkManager::isAllowed(const webrtc::Network * network) const
+	{
+		int type = network->type();
+
+		if (type & kCellularAdapterTypes) {
+			type |= webrtc::ADAPTER_TYPE_CELLULAR;
+		}
+		if (type & ignoreMask) {
+			return false;
+		}
+		if (disableIpv6 && network->prefix().family() == AF_INET6) {
+			return false;
+		}
+
+		for (const auto & matcher : denyList) {
+			if (matcher.matches(network)) {
+				return false;
+			}
+		}
+
+		if (allowList.empty()) {
+			return true;
+		}
+
+		for (const auto & matcher : allowList) {
+			if (matcher.matches(network)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void FilteringNetworkManager::onNetworksChanged()
+	{
+		SignalNetworksChanged();
+	}
+
+	FilteringPortAllocator::FilteringPortAllocator(const webrtc::Environment & env, std::unique_ptr<FilteringNetworkManager> networkManager, webrtc::PacketSocketFactory * socketFactory) :
+		FilteringNetworkManagerHolder(std::move(networkManager)),
+		webrtc::BasicPortAllocator(env, filteringNetworkManager.get(), socketFactory)
+	{
+	}
+}
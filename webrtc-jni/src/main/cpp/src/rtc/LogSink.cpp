@@ -15,16 +15,76 @@
  */
 
 #include "rtc/LogSink.h"
+#include "JavaContext.h"
 #include "JavaEnums.h"
 #include "JavaString.h"
+#include "JavaUtils.h"
 #include "JNI_WebRTC.h"
 
+#include "rtc_base/platform_thread_types.h"
+#include "rtc_base/time_utils.h"
+
+#include <chrono>
+#include <string_view>
+
 namespace jni
 {
-	LogSink::LogSink(JNIEnv * env, const JavaGlobalRef<jobject> & javaSink) :
+	// Maximum number of records passed to Java with a single call.
+	static constexpr size_t kBatchSize = 256;
+
+	// Returns the source file name of a formatted log line, e.g. "port.cc" in
+	// "(port.cc:123): message". Leading timestamp and thread tags do not
+	// contain parentheses.
+	static std::string_view GetTag(const std::string & message)
+	{
+		size_t begin = message.find('(');
+
+		if (begin == std::string::npos) {
+			return {};
+		}
+
+		size_t end = message.find(':', begin);
+
+		if (end == std::string::npos) {
+			return {};
+		}
+
+		return std::string_view(message).substr(begin + 1, end - begin - 1);
+	}
+
+	LogSink::LogSink(JNIEnv * env, const JavaGlobalRef<jobject> & javaSink, const LogSinkOptions & options) :
 		javaSink(javaSink),
-		javaClass(JavaClasses::get<JavaLogSinkClass>(env))
+		options(options),
+		ring(options.capacity),
+		dropped(0),
+		rateWindow(0),
+		rateCount(0),
+		running(true),
+		javaClass(JavaClasses::get<JavaLogSinkClass>(env)),
+		javaRecordClass(JavaClasses::get<JavaLogRecordClass>(env))
+	{
+		// Resolve the Java severities once instead of per message.
+		for (int severity = webrtc::LS_VERBOSE; severity <= webrtc::LS_NONE; severity++) {
+			JavaLocalRef<jobject> jSeverity = JavaEnums::toJava(env, static_cast<webrtc::LoggingSeverity>(severity));
+
+			severities.emplace_back(env, jSeverity);
+		}
+
+		thread = std::thread(&LogSink::run, this);
+	}
+
+	LogSink::~LogSink()
 	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+
+		wakeup.notify_one();
+
+		if (thread.joinable()) {
+			thread.join();
+		}
 	}
 
 	void LogSink::OnLogMessage(const std::string & message)
@@ -33,24 +93,159 @@ namespace jni
 
 	void LogSink::OnLogMessage(const std::string & message, webrtc::LoggingSeverity severity)
 	{
-		JNIEnv * env = AttachCurrentThread();
+		if (!accept(message)) {
+			return;
+		}
+
+		LogRecord record;
+		record.severity = severity;
+		record.timestamp = webrtc::TimeUTCMillis();
+		record.threadId = static_cast<int64_t>(webrtc::CurrentThreadId());
+		record.message = message;
+
+		if (!ring.push(std::move(record))) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (ring.size() >= ring.capacity() / 2) {
+			// Flush early rather than dropping messages at the next burst.
+			wakeup.notify_one();
+		}
+	}
+
+	bool LogSink::accept(const std::string & message)
+	{
+		if (!options.excludedTags.empty()) {
+			std::string_view tag = GetTag(message);
+
+			for (const auto & excluded : options.excludedTags) {
+				if (tag == excluded) {
+					return false;
+				}
+			}
+		}
+
+		if (options.maxMessagesPerSecond > 0) {
+			// Approximate limit, messages racing with a window change may pass.
+			int64_t second = webrtc::TimeMillis() / 1000;
+			int64_t window = rateWindow.load(std::memory_order_relaxed);
+
+			if (window != second && rateWindow.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+				rateCount.store(0, std::memory_order_relaxed);
+			}
 
-        if (env == nullptr) {
+			return rateCount.fetch_add(1, std::memory_order_relaxed) < options.maxMessagesPerSecond;
+		}
+
+		return true;
+	}
+
+	void LogSink::run()
+	{
+		JavaVM * vm = javaContext->getVM();
+		JNIEnv * env = nullptr;
+
+		// A daemon thread does not keep the JVM from shutting down.
+		if (vm->AttachCurrentThreadAsDaemon(reinterpret_cast<void **>(&env), nullptr) != JNI_OK) {
 			return;
 		}
 
-		JavaLocalRef<jobject> jSeverity = JavaEnums::toJava(env, severity);
-		JavaLocalRef<jstring> jMessage = JavaString::toJava(env, message);
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (running) {
+			wakeup.wait_for(lock, std::chrono::milliseconds(options.flushInterval));
+
+			lock.unlock();
+			flush(env);
+			lock.lock();
+		}
 
-		env->CallVoidMethod(javaSink, javaClass->onLogMessage, jSeverity.get(), jMessage.get());
+		lock.unlock();
+		flush(env);
 
-		ExceptionCheck(env);
+		vm->DetachCurrentThread();
+	}
+
+	void LogSink::flush(JNIEnv * env)
+	{
+		std::vector<LogRecord> batch;
+		batch.reserve(kBatchSize);
+
+		LogRecord record;
+		bool empty = false;
+
+		while (!empty) {
+			while (batch.size() < kBatchSize) {
+				if (!ring.pop(record)) {
+					empty = true;
+					break;
+				}
+
+				batch.push_back(std::move(record));
+			}
+
+			if (empty) {
+				uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+
+				if (lost > 0) {
+					LogRecord warning;
+					warning.severity = webrtc::LS_WARNING;
+					warning.timestamp = webrtc::TimeUTCMillis();
+					warning.threadId = static_cast<int64_t>(webrtc::CurrentThreadId());
+					warning.message = std::to_string(lost) + " log messages dropped, the log buffer was full\n";
+
+					batch.push_back(std::move(warning));
+				}
+			}
+
+			if (batch.empty()) {
+				return;
+			}
+
+			const jsize size = static_cast<jsize>(batch.size());
+
+			try {
+				JavaLocalRef<jobjectArray> jRecords(env, env->NewObjectArray(size, javaRecordClass->cls, nullptr));
+
+				for (jsize i = 0; i < size; i++) {
+					const LogRecord & r = batch[i];
+
+					JavaLocalRef<jstring> jMessage = JavaString::toJava(env, r.message);
+					JavaLocalRef<jobject> jRecord(env, env->NewObject(javaRecordClass->cls, javaRecordClass->ctor,
+						severities[r.severity].get(), static_cast<jlong>(r.timestamp), static_cast<jlong>(r.threadId),
+						jMessage.get()));
+
+					env->SetObjectArrayElement(jRecords.get(), i, jRecord.get());
+				}
+
+				env->CallVoidMethod(javaSink, javaClass->onLogMessages, jRecords.get());
+
+				ExceptionCheck(env);
+			}
+			catch (...) {
+				// The exception has been reported, keep delivering.
+			}
+
+			batch.clear();
+		}
+	}
+
+	bool LogSink::delivers(JNIEnv * env, jobject sink) const
+	{
+		return env->IsSameObject(javaSink.get(), sink);
 	}
 
 	LogSink::JavaLogSinkClass::JavaLogSinkClass(JNIEnv * env)
 	{
 		jclass cls = FindClass(env, PKG_LOG"LogSink");
 
-		onLogMessage = GetMethod(env, cls, "onLogMessage", "(L" PKG_LOG "Logging$Severity;" STRING_SIG ")V");
+		onLogMessages = GetMethod(env, cls, "onLogMessages", "([L" PKG_LOG "LogRecord;)V");
+	}
+
+	LogSink::JavaLogRecordClass::JavaLogRecordClass(JNIEnv * env)
+	{
+		cls = FindClass(env, PKG_LOG"LogRecord");
+
+		ctor = GetMethod(env, cls, "<init>", "(L" PKG_LOG "Logging$Severity;JJ" STRING_SIG ")V");
 	}
 }
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rtc/LogSinkConfig.h"
+#include "JavaClasses.h"
+#include "JavaObject.h"
+#include "JavaString.h"
+#include "JavaUtils.h"
+#include "JNI_WebRTC.h"
+
+namespace jni
+{
+	namespace LogSinkConfig
+	{
+		LogSinkOptions toNative(JNIEnv * env, const JavaRef<jobject> & javaType)
+		{
+			const auto javaClass = JavaClasses::get<JavaLogSinkConfigClass>(env);
+
+			JavaObject obj(env, javaType);
+
+			LogSinkOptions options;
+			options.capacity = static_cast<size_t>(obj.getInt(javaClass->capacity));
+			options.flushInterval = obj.getInt(javaClass->flushInterval);
+			options.maxMessagesPerSecond = obj.getInt(javaClass->maxMessagesPerSecond);
+
+			JavaLocalRef<jobjectArray> tags = obj.getObjectArray(javaClass->excludedTags);
+
+			if (tags.get() != nullptr) {
+				const jsize length = env->GetArrayLength(tags.get());
+
+				for (jsize i = 0; i < length; i++) {
+					JavaLocalRef<jstring> tag(env, static_cast<jstring>(env->GetObjectArrayElement(tags.get(), i)));
+
+					if (tag.get() != nullptr) {
+						options.excludedTags.push_back(JavaString::toNative(env, tag));
+					}
+				}
+			}
+
+			return options;
+		}
+
+		JavaLogSinkConfigClass::JavaLogSinkConfigClass(JNIEnv * env)
+		{
+			cls = FindClass(env, PKG_LOG"LogSinkConfig");
+
+			capacity = GetFieldID(env, cls, "capacity", "I");
+			flushInterval = GetFieldID(env, cls, "flushInterval", "I");
+			maxMessagesPerSecond = GetFieldID(env, cls, "maxMessagesPerSecond", "I");
+			excludedTags = GetFieldID(env, cls, "excludedTags", "[" STRING_SIG);
+		}
+	}
+}
@@ -0,0 +1,497 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rtc/SharedUdpPort.h"
+
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+#include <cerrno>
+#include <vector>
+
+namespace jni
+{
+	static constexpr uint16_t kStunUsernameAttribute = 0x0006;
+
+	// Longer than the retransmission period of STUN requests.
+	static constexpr int64_t kTransactionTimeoutMs = 40000;
+
+	// Expired transactions are removed once this many are pending.
+	static constexpr size_t kTransactionPruneSize = 256;
+
+	enum class StunClass
+	{
+		kNone,
+		kRequest,
+		kIndication,
+		kResponse
+	};
+
+	/*
+	 * Returns the class of a STUN message, or kNone for other datagrams.
+	 */
+	static StunClass GetStunClass(const uint8_t * data, size_t size)
+	{
+		// Header: message type, message length, magic cookie, transaction id.
+		if (size < 20 || (data[0] & 0xC0) != 0) {
+			return StunClass::kNone;
+		}
+		if (data[4] != 0x21 || data[5] != 0x12 || data[6] != 0xA4 || data[7] != 0x42) {
+			return StunClass::kNone;
+		}
+
+		// The class bits are C1 (0x0100) and C0 (0x0010) of the message type.
+		switch (((data[0] & 0x01) << 1) | ((data[1] & 0x10) >> 4)) {
+			case 0:
+				return StunClass::kRequest;
+			case 1:
+				return StunClass::kIndication;
+			default:
+				return StunClass::kResponse;
+		}
+	}
+
+	static std::string GetStunTransactionId(const uint8_t * data)
+	{
+		return std::string(reinterpret_cast<const char *>(data + 8), 12);
+	}
+
+	/*
+	 * Reads the USERNAME attribute of a STUN binding request.
+	 */
+	static bool ReadStunUsername(const uint8_t * data, size_t size, std::string & username)
+	{
+		if (GetStunClass(data, size) != StunClass::kRequest || data[0] != 0x00 || data[1] != 0x01) {
+			return false;
+		}
+
+		const size_t end = 20 + ((data[2] << 8) | data[3]);
+
+		if (end > size) {
+			return false;
+		}
+
+		size_t offset = 20;
+
+		while (offset + 4 <= end) {
+			const uint16_t type = (data[offset] << 8) | data[offset + 1];
+			const size_t length = (data[offset + 2] << 8) | data[offset + 3];
+
+			offset += 4;
+
+			if (offset + length > end) {
+				return false;
+			}
+			if (type == kStunUsernameAttribute) {
+				username.assign(reinterpret_cast<const char *>(data + offset), length);
+				return true;
+			}
+
+			// Attributes are padded to a multiple of four bytes.
+			offset += (length + 3) & ~static_cast<size_t>(3);
+		}
+
+		return false;
+	}
+
+	SharedUdpPort::SharedUdpPort(webrtc::SocketFactory * socketFactory, uint16_t port) :
+		factory(socketFactory),
+		port(port),
+		socketSequence(0)
+	{
+	}
+
+	SharedUdpPort::~SharedUdpPort()
+	{
+		for (auto & entry : endpoints) {
+			entry.second->socket->DeregisterReceivedPacketCallback();
+		}
+	}
+
+	webrtc::AsyncPacketSocket * SharedUdpPort::createSocket(const webrtc::SocketAddress & address, const void * owner)
+	{
+		const webrtc::IPAddress ip = address.ipaddr();
+
+		auto it = endpoints.find(ip);
+
+		if (it == endpoints.end()) {
+			std::unique_ptr<webrtc::AsyncPacketSocket> socket(factory.CreateUdpSocket(webrtc::SocketAddress(ip, 0), port, port));
+
+			if (!socket) {
+				RTC_LOG(LS_ERROR) << "Bind shared UDP port " << port << " on " << ip.ToString() << " failed";
+				return nullptr;
+			}
+
+			auto endpoint = std::make_unique<Endpoint>();
+			Endpoint * e = endpoint.get();
+
+			socket->RegisterReceivedPacketCallback([this, e](webrtc::AsyncPacketSocket *, const webrtc::ReceivedIpPacket & packet) {
+				onPacketReceived(e, packet);
+			});
+			socket->SignalSentPacket.connect(this, &SharedUdpPort::onSentPacket);
+			socket->SignalReadyToSend.connect(this, &SharedUdpPort::onReadyToSend);
+
+			endpoint->socket = std::move(socket);
+
+			it = endpoints.emplace(ip, std::move(endpoint)).first;
+		}
+
+		Endpoint * endpoint = it->second.get();
+
+		SharedUdpSocket * socket = new SharedUdpSocket(shared_from_this(), endpoint->socket.get(), owner, ++socketSequence);
+		endpoint->sockets.insert(socket);
+
+		return socket;
+	}
+
+	void SharedUdpPort::addUfrag(const std::string & ufrag, const void * owner)
+	{
+		localUfrags[ufrag] = owner;
+	}
+
+	void SharedUdpPort::removeUfrag(const std::string & ufrag, const void * owner)
+	{
+		auto it = localUfrags.find(ufrag);
+
+		if (it != localUfrags.end() && it->second == owner) {
+			localUfrags.erase(it);
+		}
+	}
+
+	int SharedUdpPort::sendTo(SharedUdpSocket * socket, const void * data, size_t size, const webrtc::SocketAddress & address, const webrtc::AsyncSocketPacketOptions & options)
+	{
+		Endpoint * endpoint = findEndpoint(socket->socket);
+
+		if (endpoint == nullptr) {
+			return -1;
+		}
+
+		const uint8_t * bytes = static_cast<const uint8_t *>(data);
+
+		if (GetStunClass(bytes, size) == StunClass::kRequest) {
+			// Several connections may send requests to the same remote, e.g.
+			// a STUN server. Responses are matched by transaction ID.
+			addTransaction(endpoint, GetStunTransactionId(bytes), socket);
+
+			std::string username;
+
+			if (ReadStunUsername(bytes, size, username)) {
+				// Outbound binding requests carry "remote:local".
+				size_t separator = username.find(':');
+
+				if (separator != std::string::npos) {
+					endpoint->ufrags[username.substr(separator + 1)] = socket;
+				}
+			}
+		}
+		else {
+			// Other datagrams from this remote address belong to the sending socket.
+			endpoint->remotes[address] = socket;
+		}
+
+		endpoint->sending = socket;
+
+		int result = endpoint->socket->SendTo(data, size, address, options);
+
+		endpoint->sending = nullptr;
+
+		return result;
+	}
+
+	void SharedUdpPort::remove(SharedUdpSocket * socket)
+	{
+		for (auto & entry : endpoints) {
+			Endpoint * endpoint = entry.second.get();
+
+			if (endpoint->sockets.erase(socket) == 0) {
+				continue;
+			}
+
+			std::erase_if(endpoint->remotes, [socket](const auto & item) { return item.second == socket; });
+			std::erase_if(endpoint->ufrags, [socket](const auto & item) { return item.second == socket; });
+			std::erase_if(endpoint->transactions, [socket](const auto & item) { return item.second.socket == socket; });
+
+			if (endpoint->sending == socket) {
+				endpoint->sending = nullptr;
+			}
+		}
+	}
+
+	void SharedUdpPort::onPacketReceived(Endpoint * endpoint, const webrtc::ReceivedIpPacket & packet)
+	{
+		SharedUdpSocket * target = nullptr;
+
+		const uint8_t * data = packet.payload().data();
+		const size_t size = packet.payload().size();
+		const StunClass stunClass = GetStunClass(data, size);
+
+		if (stunClass == StunClass::kResponse) {
+			auto transaction = endpoint->transactions.find(GetStunTransactionId(data));
+
+			if (transaction != endpoint->transactions.end()) {
+				target = transaction->second.socket;
+
+				endpoint->transactions.erase(transaction);
+			}
+		}
+		else if (stunClass == StunClass::kRequest) {
+			std::string username;
+
+			if (ReadStunUsername(data, size, username)) {
+				// Inbound binding requests carry "local:remote".
+				target = findByUfrag(endpoint, username.substr(0, username.find(':')));
+
+				if (target != nullptr) {
+					endpoint->remotes[packet.source_address()] = target;
+				}
+			}
+		}
+
+		if (target == nullptr) {
+			auto it = endpoint->remotes.find(packet.source_address());
+
+			if (it != endpoint->remotes.end()) {
+				target = it->second;
+			}
+		}
+
+		if (target == nullptr) {
+			RTC_LOG(LS_VERBOSE) << "Dropping packet from unknown remote " << packet.source_address().ToSensitiveString();
+			return;
+		}
+
+		target->deliver(packet);
+	}
+
+	void SharedUdpPort::onSentPacket(webrtc::AsyncPacketSocket * socket, const webrtc::SentPacketInfo & info)
+	{
+		Endpoint * endpoint = findEndpoint(socket);
+
+		if (endpoint != nullptr && endpoint->sending != nullptr) {
+			endpoint->sending->SignalSentPacket(endpoint->sending, info);
+		}
+	}
+
+	void SharedUdpPort::onReadyToSend(webrtc::AsyncPacketSocket * socket)
+	{
+		Endpoint * endpoint = findEndpoint(socket);
+
+		if (endpoint == nullptr) {
+			return;
+		}
+
+		// Handlers may close sockets.
+		std::vector<SharedUdpSocket *> sockets(endpoint->sockets.begin(), endpoint->sockets.end());
+
+		for (SharedUdpSocket * s : sockets) {
+			if (endpoint->sockets.count(s) != 0) {
+				s->SignalReadyToSend(s);
+			}
+		}
+	}
+
+	SharedUdpPort::Endpoint * SharedUdpPort::findEndpoint(webrtc::AsyncPacketSocket * socket)
+	{
+		for (auto & entry : endpoints) {
+			if (entry.second->socket.get() == socket) {
+				return entry.second.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	SharedUdpSocket * SharedUdpPort::findByUfrag(Endpoint * endpoint, const std::string & ufrag)
+	{
+		// Learned from outbound binding requests of the socket.
+		auto learned = endpoint->ufrags.find(ufrag);
+
+		if (learned != endpoint->ufrags.end()) {
+			return learned->second;
+		}
+
+		auto local = localUfrags.find(ufrag);
+
+		if (local == localUfrags.end()) {
+			return nullptr;
+		}
+
+		// The connection did not send any request yet, e.g. since the remote
+		// peer only announced mDNS candidates. Use its newest socket.
+		SharedUdpSocket * target = nullptr;
+
+		for (SharedUdpSocket * socket : endpoint->sockets) {
+			if (socket->owner == local->second && (target == nullptr || socket->sequence > target->sequence)) {
+				target = socket;
+			}
+		}
+
+		if (target != nullptr) {
+			endpoint->ufrags[ufrag] = target;
+		}
+
+		return target;
+	}
+
+	void SharedUdpPort::addTransaction(Endpoint * endpoint, const std::string & id, SharedUdpSocket * socket)
+	{
+		const int64_t now = webrtc::TimeMillis();
+
+		if (endpoint->transactions.size() >= kTransactionPruneSize) {
+			// Requests that were never answered.
+			std::erase_if(endpoint->transactions, [now](const auto & item) {
+				return now - item.second.timeMs > kTransactionTimeoutMs;
+			});
+		}
+
+		endpoint->transactions[id] = Transaction { socket, now };
+	}
+
+	SharedUdpSocket::SharedUdpSocket(const std::shared_ptr<SharedUdpPort> & port, webrtc::AsyncPacketSocket * socket, const void * owner, uint64_t sequence) :
+		port(port),
+		socket(socket),
+		owner(owner),
+		sequence(sequence),
+		state(STATE_BOUND),
+		error(0)
+	{
+	}
+
+	SharedUdpSocket::~SharedUdpSocket()
+	{
+		Close();
+	}
+
+	webrtc::SocketAddress SharedUdpSocket::GetLocalAddress() const
+	{
+		return socket->GetLocalAddress();
+	}
+
+	webrtc::SocketAddress SharedUdpSocket::GetRemoteAddress() const
+	{
+		return webrtc::SocketAddress();
+	}
+
+	int SharedUdpSocket::Send(const void * data, size_t size, const webrtc::AsyncSocketPacketOptions & options)
+	{
+		// Not connected, only SendTo is supported.
+		error = ENOTCONN;
+
+		return -1;
+	}
+
+	int SharedUdpSocket::SendTo(const void * data, size_t size, const webrtc::SocketAddress & address, const webrtc::AsyncSocketPacketOptions & options)
+	{
+		if (state == STATE_CLOSED) {
+			error = EBADF;
+			return -1;
+		}
+
+		return port->sendTo(this, data, size, address, options);
+	}
+
+	int SharedUdpSocket::Close()
+	{
+		if (state != STATE_CLOSED) {
+			port->remove(this);
+			state = STATE_CLOSED;
+		}
+
+		return 0;
+	}
+
+	webrtc::AsyncPacketSocket::State SharedUdpSocket::GetState() const
+	{
+		return state;
+	}
+
+	int SharedUdpSocket::GetOption(webrtc::Socket::Option option, int * value)
+	{
+		return socket->GetOption(option, value);
+	}
+
+	int SharedUdpSocket::SetOption(webrtc::Socket::Option option, int value)
+	{
+		return socket->SetOption(option, value);
+	}
+
+	int SharedUdpSocket::GetError() const
+	{
+		return error != 0 ? error : socket->GetError();
+	}
+
+	void SharedUdpSocket::SetError(int error)
+	{
+		this->error = error;
+	}
+
+	void SharedUdpSocket::deliver(const webrtc::ReceivedIpPacket & packet)
+	{
+		NotifyPacketReceived(packet);
+	}
+
+	SharedUdpPacketSocketFactory::SharedUdpPacketSocketFactory(webrtc::SocketFactory * socketFactory, const std::shared_ptr<SharedUdpPort> & port) :
+		webrtc::BasicPacketSocketFactory(socketFactory),
+		port(port)
+	{
+	}
+
+	webrtc::AsyncPacketSocket * SharedUdpPacketSocketFactory::CreateUdpSocket(const webrtc::SocketAddress & address, uint16_t minPort, uint16_t maxPort)
+	{
+		return port->createSocket(address, this);
+	}
+
+	SharedUdpPortAllocatorSession::SharedUdpPortAllocatorSession(webrtc::BasicPortAllocator * allocator, SharedUdpPacketSocketFactory * socketFactory,
+		absl::string_view contentName, int component, absl::string_view ufrag, absl::string_view pwd) :
+		webrtc::BasicPortAllocatorSession(allocator, contentName, component, ufrag, pwd),
+		port(socketFactory->getPort()),
+		owner(socketFactory),
+		ufrag(ufrag)
+	{
+		port->addUfrag(this->ufrag, owner);
+	}
+
+	SharedUdpPortAllocatorSession::~SharedUdpPortAllocatorSession()
+	{
+		port->removeUfrag(ufrag, owner);
+	}
+
+	void SharedUdpPortAllocatorSession::UpdateIceParametersInternal()
+	{
+		webrtc::BasicPortAllocatorSession::UpdateIceParametersInternal();
+
+		// A pooled session takes the ufrag of the transport using it.
+		port->removeUfrag(ufrag, owner);
+
+		ufrag = ice_ufrag();
+
+		port->addUfrag(ufrag, owner);
+	}
+
+	SharedUdpPortAllocator::SharedUdpPortAllocator(const webrtc::Environment & env, webrtc::NetworkManager * networkManager,
+		std::unique_ptr<FilteringNetworkManager> filteringNetworkManager, std::unique_ptr<SharedUdpPacketSocketFactory> socketFactory) :
+		FilteringNetworkManagerHolder(std::move(filteringNetworkManager)),
+		SharedUdpSocketFactoryHolder(std::move(socketFactory)),
+		webrtc::BasicPortAllocator(env, this->filteringNetworkManager ? this->filteringNetworkManager.get() : networkManager, sharedUdpSocketFactory.get())
+	{
+	}
+
+	webrtc::PortAllocatorSession * SharedUdpPortAllocator::CreateSessionInternal(absl::string_view contentName, int component,
+		absl::string_view ufrag, absl::string_view pwd)
+	{
+		return new SharedUdpPortAllocatorSession(this, sharedUdpSocketFactory.get(), contentName, component, ufrag, pwd);
+	}
+}
@@ -35,6 +35,9 @@ tasks.named<Test>("test") {
     useJUnitPlatform()
     
     modularity.inferModulePath.set(false)
+
+    // Benchmarks run with -Dwebrtc.benchmark=true.
+    System.getProperty("webrtc.benchmark")?.let { systemProperty("webrtc.benchmark", it) }
     
     testLogging {
         events("passed", "skipped", "failed")
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import dev.kastle.webrtc.internal.RefCountedObject;
+
+/**
+ * An {@link RTCConfiguration} converted to its native form once by {@link
+ * PeerConnectionFactory#compileConfiguration(RTCConfiguration)}. Creating
+ * peer connections from it skips the conversion of the Java configuration.
+ * Later changes to the source configuration are not reflected.
+ * <p>
+ * Call {@link #release()} when no more peer connections are created from
+ * this configuration. Peer connections already created are not affected.
+ *
+ * @author Alex Andres
+ */
+public class CompiledRTCConfiguration extends RefCountedObject {
+
+	/**
+	 * Constructor used by the native api.
+	 */
+	private CompiledRTCConfiguration() {
+
+	}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import dev.kastle.webrtc.internal.RefCountedObject;
+
+/**
+ * An {@link RTCDataChannelInit} converted to its native form once by {@link
+ * PeerConnectionFactory#compileDataChannelInit(RTCDataChannelInit)}.
+ * Creating data channels from it skips the conversion of the Java
+ * dictionary. Later changes to the source dictionary are not reflected.
+ * <p>
+ * Call {@link #release()} when no more data channels are created from this
+ * dictionary. Data channels already created are not affected.
+ *
+ * @author Alex Andres
+ */
+public class CompiledRTCDataChannelInit extends RefCountedObject {
+
+	/**
+	 * Constructor used by the native api.
+	 */
+	private CompiledRTCDataChannelInit() {
+
+	}
+
+}
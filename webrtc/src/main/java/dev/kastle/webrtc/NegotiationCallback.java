@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * Callback interface used by the combined negotiation operations {@link
+ * RTCPeerConnection#createAndSetLocalOffer createAndSetLocalOffer} and {@link
+ * RTCPeerConnection#answerRemoteOffer answerRemoteOffer}.
+ *
+ * @author Alex Andres
+ */
+public interface NegotiationCallback {
+
+	/**
+	 * The local description has been created and applied.
+	 *
+	 * @param sdp The SDP of the applied local offer or answer.
+	 */
+	void onSuccess(String sdp);
+
+	/**
+	 * An error has occurred in one of the negotiation steps. The steps
+	 * completed before remain applied.
+	 *
+	 * @param error The error message.
+	 */
+	void onFailure(String error);
+
+}
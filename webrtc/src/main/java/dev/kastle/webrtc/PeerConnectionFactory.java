@@ -19,6 +19,11 @@ package dev.kastle.webrtc;
 import dev.kastle.webrtc.internal.DisposableNativeObject;
 import dev.kastle.webrtc.internal.NativeLoader;
 
+import static java.util.Objects.requireNonNull;
+
+import java.util.Collection;
+import java.util.concurrent.CompletableFuture;
+
 /**
  * The PeerConnectionFactory is the main entry point for a WebRTC application.
  * It provides factory methods for {@link RTCPeerConnection}.
@@ -36,19 +41,31 @@ public class PeerConnectionFactory extends DisposableNativeObject {
 		}
 	}
 
-
-	private long networkThreadHandle;
-
-	private long signalingThreadHandle;
-
-	private long workerThreadHandle;
+	/**
+	 * The thread that drives the signaling loop, if the factory was created
+	 * with an application signaling thread.
+	 */
+	private final Thread applicationThread;
 
 
     /**
      * Creates an instance of PeerConnectionFactory.
      */
     public PeerConnectionFactory() {
-        initialize();
+        this(new PeerConnectionFactoryConfig());
+    }
+
+    /**
+     * Creates an instance of PeerConnectionFactory with the given thread
+     * configuration.
+     *
+     * @param config The factory configuration.
+     */
+    public PeerConnectionFactory(PeerConnectionFactoryConfig config) {
+        initialize(config);
+
+        applicationThread = config.applicationSignalingThread ?
+                Thread.currentThread() : null;
     }
 
 	/**
@@ -63,12 +80,203 @@ public class PeerConnectionFactory extends DisposableNativeObject {
 	public native RTCPeerConnection createPeerConnection(
 			RTCConfiguration config, PeerConnectionObserver observer);
 
+	/**
+	 * Creates a new {@link RTCPeerConnection} from a precompiled
+	 * configuration.
+	 *
+	 * @param config   The compiled peer connection configuration.
+	 * @param observer The observer that receives peer connection state
+	 *                 changes.
+	 *
+	 * @return The created peer connection.
+	 */
+	public native RTCPeerConnection createPeerConnectionCompiled(
+			CompiledRTCConfiguration config, PeerConnectionObserver observer);
+
+	/**
+	 * Converts the configuration to its native form, so that many peer
+	 * connections can be created from it without converting it each time.
+	 *
+	 * @param config The peer connection configuration.
+	 *
+	 * @return The immutable compiled configuration.
+	 */
+	public native CompiledRTCConfiguration compileConfiguration(
+			RTCConfiguration config);
+
+	/**
+	 * Converts the data channel dictionary to its native form, so that many
+	 * data channels can be created from it without converting it each time.
+	 *
+	 * @param dict The data channel configuration.
+	 *
+	 * @return The immutable compiled data channel configuration.
+	 *
+	 * @see RTCPeerConnection#createDataChannels(String[],
+	 * CompiledRTCDataChannelInit[])
+	 */
+	public native CompiledRTCDataChannelInit compileDataChannelInit(
+			RTCDataChannelInit dict);
+
+	/**
+	 * Returns the number of open peer connections on each shard of this
+	 * factory. The array has one entry per configured shard.
+	 *
+	 * @return The per-shard peer connection count.
+	 */
+	public native int[] getShardLoad();
+
+	/**
+	 * Returns the number of datagrams sent with UDP segmentation offload by
+	 * all shards of this factory. Stays zero unless {@link
+	 * PeerConnectionFactoryConfig#udpOffload} is enabled and supported by the
+	 * kernel and the route.
+	 *
+	 * @return The number of offloaded datagrams.
+	 */
+	public native long getOffloadedDatagrams();
+
+	/**
+	 * Checks whether the kernel supports UDP segmentation offload, by sending
+	 * a segmented datagram over loopback. If not, {@link
+	 * PeerConnectionFactoryConfig#udpOffload} has no effect.
+	 *
+	 * @return true if UDP segmentation offload is supported.
+	 */
+	public static native boolean isUdpOffloadSupported();
+
+	/**
+	 * Closes many peer connections without blocking the calling thread. The
+	 * connections are closed in batches on the signaling thread of their
+	 * shard, so that connections on different shards are closed in parallel.
+	 * Each connection behaves as closed as soon as this method returns. Null
+	 * entries and connections that are already closed are skipped.
+	 * <p>
+	 * With an application signaling thread, the connections are closed while
+	 * {@link #processMessages(int)} is called.
+	 *
+	 * @param connections The peer connections to close.
+	 *
+	 * @return A future completed once all connections are closed.
+	 */
+	public CompletableFuture<Void> closeAll(
+			Collection<RTCPeerConnection> connections) {
+		requireNonNull(connections, "RTCPeerConnection collection must not be null");
+
+		return RTCPeerConnection.closeAll(
+				connections.toArray(new RTCPeerConnection[0]));
+	}
+
+	/**
+	 * Processes pending signaling messages and delivers peer connection
+	 * callbacks on the calling thread. Only available if the factory was
+	 * created with {@link PeerConnectionFactoryConfig#applicationSignalingThread}
+	 * and must be called on the thread that created the factory. Messages are
+	 * processed as they arrive until the timeout elapses. A timeout of {@code
+	 * 0} only processes the already pending messages, a timeout of {@code -1}
+	 * processes messages until the thread is stopped.
+	 *
+	 * @param timeoutMs The time to process messages for in milliseconds.
+	 *
+	 * @return false if the signaling thread has been stopped.
+	 */
+	public native boolean processMessages(int timeoutMs);
+
+	/**
+	 * Generates a DTLS certificate with the default lifetime of 30 days.
+	 *
+	 * @param keyType The key algorithm of the certificate.
+	 *
+	 * @return The generated certificate.
+	 */
+	public RTCCertificate generateCertificate(RTCKeyType keyType) {
+		return generateCertificate(keyType, 0);
+	}
+
+	/**
+	 * Generates a DTLS certificate on the calling thread. The certificate can
+	 * be shared by many peer connections using {@link
+	 * RTCConfiguration#nativeCertificates}.
+	 *
+	 * @param keyType   The key algorithm of the certificate.
+	 * @param expiresMs The lifetime of the certificate in milliseconds, or 0
+	 *                  for the default lifetime.
+	 *
+	 * @return The generated certificate.
+	 */
+	public native RTCCertificate generateCertificate(RTCKeyType keyType,
+			long expiresMs);
+
+	/**
+	 * Generates a DTLS certificate in the background, e.g. to have
+	 * certificates ready before peer connections are created. The key is
+	 * generated on the worker thread of a shard and the future is completed
+	 * on its signaling thread, so no Java thread is occupied. With {@link
+	 * PeerConnectionFactoryConfig#applicationSignalingThread} the future is
+	 * completed while {@link #processMessages(int)} is running. Generations
+	 * still running when the factory is disposed complete exceptionally.
+	 *
+	 * @param keyType The key algorithm of the certificate.
+	 *
+	 * @return A future completed with the generated certificate.
+	 */
+	public CompletableFuture<RTCCertificate> generateCertificateAsync(
+			RTCKeyType keyType) {
+		CompletableFuture<RTCCertificate> future = new CompletableFuture<>();
+
+		generateCertificateFuture(keyType, 0, future);
+
+		return future;
+	}
+
+	/**
+	 * Releases the native factories and stops their threads. All peer
+	 * connections created by this factory must be closed before, since they
+	 * share the network resources of their shard. Connections still queued
+	 * by {@link RTCPeerConnection#closeAsync()} or {@link #closeAll} are
+	 * closed first, so that their futures complete.
+	 *
+	 * <p>
+	 * A factory created with {@link
+	 * PeerConnectionFactoryConfig#applicationSignalingThread} must be disposed
+	 * on the thread that created it, since releasing the factory requires that
+	 * thread to process messages.
+	 *
+	 * @throws IllegalStateException If a peer connection of this factory is
+	 *                               still open, or if called on another
+	 *                               thread than the application signaling
+	 *                               thread.
+	 */
 	@Override
-	public native void dispose();
+	public void dispose() {
+		if (applicationThread != null
+				&& Thread.currentThread() != applicationThread) {
+			throw new IllegalStateException(
+					"Factory must be disposed on its application signaling thread");
+		}
+
+		flushSignalingThreads();
+
+		for (int load : getShardLoad()) {
+			if (load > 0) {
+				throw new IllegalStateException(
+						"Peer connections of this factory are still open");
+			}
+		}
+
+		disposeFactory();
+	}
 
     /**
      * Initializes the native PeerConnectionFactory.
      */
-    private native void initialize();
+    private native void initialize(PeerConnectionFactoryConfig config);
+
+	private native void flushSignalingThreads();
+
+	private native void disposeFactory();
+
+	private native void generateCertificateFuture(RTCKeyType keyType,
+			long expiresMs, CompletableFuture<RTCCertificate> future);
 
 }
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * Configuration of the native threads used by a {@link PeerConnectionFactory}.
+ * <p>
+ * By default a factory runs all peer connections on one network, one
+ * signaling and one worker thread. With more than one shard, each shard gets
+ * its own thread triplet and native factory, and new peer connections are
+ * distributed over the shards according to the {@link #placement} policy. A
+ * peer connection stays on its shard for its whole lifetime.
+ *
+ * @author Alex Andres
+ */
+public class PeerConnectionFactoryConfig {
+
+	/**
+	 * The number of independent factory shards, at least 1.
+	 */
+	public int shards = 1;
+
+	/**
+	 * The policy used to place new peer connections on a shard.
+	 */
+	public PeerConnectionPlacement placement = PeerConnectionPlacement.ROUND_ROBIN;
+
+	/**
+	 * Use a single native thread as network, signaling and worker thread of
+	 * each shard. This avoids thread hops and blocking cross-thread calls for
+	 * every API call and callback, which favors latency on hosts with few
+	 * cores. All peer connections of a shard then share one core.
+	 */
+	public boolean singleThread = false;
+
+	/**
+	 * Turn the thread that creates the factory into its signaling thread.
+	 * Peer connection callbacks are then only delivered while this thread
+	 * calls {@link PeerConnectionFactory#processMessages(int)}, and API calls
+	 * made on this thread run directly without cross-thread marshalling.
+	 * Requires exactly one shard.
+	 * <p>
+	 * Calls from other threads to peer connections of this factory block until
+	 * the application thread processes messages.
+	 */
+	public boolean applicationSignalingThread = false;
+
+	/**
+	 * The socket server used by the network thread of each shard.
+	 */
+	public SocketServerType socketServer = SocketServerType.DEFAULT;
+
+	/**
+	 * Enable UDP generic segmentation and receive offload (GSO/GRO) on Linux.
+	 * Consecutive equally sized datagrams to the same peer are then sent with
+	 * a single system call, and coalesced inbound datagrams are split again
+	 * natively. Implies the {@link SocketServerType#BATCHING} socket server.
+	 * Sockets on kernels or routes without offload support fall back to
+	 * regular datagrams.
+	 */
+	public boolean udpOffload = false;
+
+
+	/**
+	 * Creates an instance with default values.
+	 */
+	public PeerConnectionFactoryConfig() {
+	}
+
+}
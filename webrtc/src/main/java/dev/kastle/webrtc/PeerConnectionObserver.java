@@ -79,6 +79,20 @@ public interface PeerConnectionObserver {
 	 */
 	void onIceCandidate(RTCIceCandidate candidate);
 
+	/**
+	 * New RTCIceCandidates are made available to the application at once.
+	 * Called instead of {@link #onIceCandidate} when the peer connection was
+	 * created with {@link RTCConfiguration#iceCandidateBatchWindow} set. By
+	 * default each candidate is passed to {@link #onIceCandidate}.
+	 *
+	 * @param candidates The new ICE candidates.
+	 */
+	default void onIceCandidates(RTCIceCandidate[] candidates) {
+		for (RTCIceCandidate candidate : candidates) {
+			onIceCandidate(candidate);
+		}
+	}
+
 	/**
 	 * A failure occurred when gathering ICE candidates.
 	 *
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * Determines on which shard of a {@link PeerConnectionFactory} a new {@link
+ * RTCPeerConnection} is placed.
+ *
+ * @author Alex Andres
+ */
+public enum PeerConnectionPlacement {
+
+	/**
+	 * Place peer connections on the shards in turn.
+	 */
+	ROUND_ROBIN,
+
+	/**
+	 * Place a peer connection on the shard with the fewest open peer
+	 * connections.
+	 */
+	LEAST_LOADED;
+
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import static java.util.Objects.requireNonNull;
+
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * Keeps a number of pre-created {@link RTCPeerConnection}s ready to take the
+ * creation cost, including DTLS certificate generation, off the critical path
+ * of a new session. Acquired connections are replaced asynchronously.
+ * <p>
+ * To also have ICE candidates gathered ahead of time, set {@link
+ * RTCConfiguration#iceCandidatePoolSize} in the pool configuration. With an
+ * application signaling thread the refill only progresses while messages are
+ * processed.
+ *
+ * @author Alex Andres
+ */
+public class PeerConnectionPool implements AutoCloseable {
+
+	private final PeerConnectionFactory factory;
+
+	private final CompiledRTCConfiguration config;
+
+	private final int size;
+
+	private final Deque<PooledConnection> idle;
+
+	private final ExecutorService executor;
+
+	private int pending;
+
+	private boolean closed;
+
+
+	/**
+	 * Creates a pool and starts filling it in the background.
+	 *
+	 * @param factory The factory to create the peer connections with.
+	 * @param config  The configuration of all pooled peer connections.
+	 * @param size    The number of idle peer connections to keep.
+	 */
+	public PeerConnectionPool(PeerConnectionFactory factory,
+			RTCConfiguration config, int size) {
+		requireNonNull(factory, "PeerConnectionFactory must not be null");
+		requireNonNull(config, "RTCConfiguration must not be null");
+
+		if (size < 1) {
+			throw new IllegalArgumentException("Invalid pool size: " + size);
+		}
+
+		this.factory = factory;
+		this.config = factory.compileConfiguration(config);
+		this.size = size;
+		this.idle = new ArrayDeque<>(size);
+		this.executor = Executors.newSingleThreadExecutor(runnable -> {
+			Thread thread = new Thread(runnable, "PeerConnectionPool");
+			thread.setDaemon(true);
+			return thread;
+		});
+
+		refill();
+	}
+
+	/**
+	 * Takes a peer connection from the pool and assigns the observer to it.
+	 * If the pool is empty, a new peer connection is created on the calling
+	 * thread.
+	 *
+	 * @param observer The observer that receives peer connection state
+	 *                 changes.
+	 *
+	 * @return The peer connection.
+	 */
+	public RTCPeerConnection acquire(PeerConnectionObserver observer) {
+		requireNonNull(observer, "PeerConnectionObserver must not be null");
+
+		PooledConnection connection;
+
+		synchronized (this) {
+			if (closed) {
+				throw new IllegalStateException("PeerConnectionPool is closed");
+			}
+
+			connection = idle.pollFirst();
+
+			if (connection == null) {
+				// Keep the configuration alive while a concurrent close()
+				// releases the reference of the pool.
+				config.retain();
+			}
+		}
+
+		if (connection == null) {
+			try {
+				connection = new PooledConnection(factory, config);
+			}
+			finally {
+				config.release();
+			}
+		}
+
+		connection.observer.setDelegate(observer);
+
+		refill();
+
+		return connection.peerConnection;
+	}
+
+	/**
+	 * Returns the number of idle peer connections ready to be acquired.
+	 *
+	 * @return The number of idle peer connections.
+	 */
+	public synchronized int available() {
+		return idle.size();
+	}
+
+	/**
+	 * Closes all idle peer connections. Acquired peer connections are not
+	 * affected and must be closed by their owners.
+	 */
+	@Override
+	public void close() {
+		Deque<PooledConnection> connections;
+
+		synchronized (this) {
+			if (closed) {
+				return;
+			}
+
+			closed = true;
+			connections = new ArrayDeque<>(idle);
+			idle.clear();
+		}
+
+		executor.shutdown();
+		config.release();
+
+		for (PooledConnection connection : connections) {
+			connection.peerConnection.close();
+		}
+	}
+
+	private synchronized void refill() {
+		while (!closed && idle.size() + pending < size) {
+			pending++;
+
+			config.retain();
+			executor.execute(this::createConnection);
+		}
+	}
+
+	private void createConnection() {
+		PooledConnection connection = null;
+
+		try {
+			connection = new PooledConnection(factory, config);
+		}
+		finally {
+			config.release();
+
+			boolean discard;
+
+			synchronized (this) {
+				pending--;
+				discard = closed;
+
+				if (!discard && connection != null) {
+					idle.addLast(connection);
+				}
+			}
+
+			if (discard && connection != null) {
+				connection.peerConnection.close();
+			}
+		}
+	}
+
+	private static class PooledConnection {
+
+		final PooledPeerConnectionObserver observer;
+
+		final RTCPeerConnection peerConnection;
+
+
+		PooledConnection(PeerConnectionFactory factory, CompiledRTCConfiguration config) {
+			observer = new PooledPeerConnectionObserver();
+			peerConnection = factory.createPeerConnectionCompiled(config, observer);
+		}
+	}
+}
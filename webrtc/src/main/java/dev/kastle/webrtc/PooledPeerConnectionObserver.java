@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * Observer of a pooled {@link RTCPeerConnection} that forwards all events to
+ * the observer of the application that acquired the connection. Events that
+ * occur while the connection is idle in the pool are dropped.
+ *
+ * @author Alex Andres
+ */
+class PooledPeerConnectionObserver implements PeerConnectionObserver {
+
+	private volatile PeerConnectionObserver delegate;
+
+
+	void setDelegate(PeerConnectionObserver delegate) {
+		this.delegate = delegate;
+	}
+
+	@Override
+	public void onSignalingChange(RTCSignalingState state) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onSignalingChange(state);
+		}
+	}
+
+	@Override
+	public void onConnectionChange(RTCPeerConnectionState state) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onConnectionChange(state);
+		}
+	}
+
+	@Override
+	public void onIceConnectionChange(RTCIceConnectionState state) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceConnectionChange(state);
+		}
+	}
+
+	@Override
+	public void onStandardizedIceConnectionChange(RTCIceConnectionState state) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onStandardizedIceConnectionChange(state);
+		}
+	}
+
+	@Override
+	public void onIceConnectionReceivingChange(boolean receiving) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceConnectionReceivingChange(receiving);
+		}
+	}
+
+	@Override
+	public void onIceGatheringChange(RTCIceGatheringState state) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceGatheringChange(state);
+		}
+	}
+
+	@Override
+	public void onIceCandidate(RTCIceCandidate candidate) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceCandidate(candidate);
+		}
+	}
+
+	@Override
+	public void onIceCandidates(RTCIceCandidate[] candidates) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceCandidates(candidates);
+		}
+	}
+
+	@Override
+	public void onIceCandidateError(RTCPeerConnectionIceErrorEvent event) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceCandidateError(event);
+		}
+	}
+
+	@Override
+	public void onIceCandidatesRemoved(RTCIceCandidate[] candidates) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onIceCandidatesRemoved(candidates);
+		}
+	}
+
+	@Override
+	public void onDataChannel(RTCDataChannel dataChannel) {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onDataChannel(dataChannel);
+		}
+	}
+
+	@Override
+	public void onRenegotiationNeeded() {
+		PeerConnectionObserver observer = delegate;
+
+		if (observer != null) {
+			observer.onRenegotiationNeeded();
+		}
+	}
+
+}
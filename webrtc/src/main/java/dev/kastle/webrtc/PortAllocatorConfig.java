@@ -16,6 +16,9 @@
 
 package dev.kastle.webrtc;
 
+import java.util.ArrayList;
+import java.util.List;
+
 /**
  * Port allocator configuration for ICE candidate gathering.
  * <p>
@@ -47,6 +50,13 @@ public class PortAllocatorConfig {
     public static final int PORTALLOCATOR_ENABLE_ANY_ADDRESS_PORTS = 0x8000;
     public static final int PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS = 0x10000;
 
+    // Network types for the ignore mask (must mirror the native adapter types).
+    public static final int NETWORK_ETHERNET = 0x01;
+    public static final int NETWORK_WIFI = 0x02;
+    public static final int NETWORK_CELLULAR = 0x04;
+    public static final int NETWORK_VPN = 0x08;
+    public static final int NETWORK_LOOPBACK = 0x10;
+
     /**
      * Minimum UDP/TCP port to use for candidate gathering, inclusive.
      * Set to 0 to leave unspecified.
@@ -64,6 +74,49 @@ public class PortAllocatorConfig {
      */
     public int flags = 0;
 
+    /**
+     * Local UDP port shared by the ICE ports of all peer connections of a
+     * factory that set the same port, e.g. to expose a server behind a single
+     * firewall rule. Inbound packets are assigned to connections by remote
+     * address and by the ICE username fragment of STUN binding requests.
+     * Since the port is bound per factory shard, factories with more than
+     * one shard reject it with an {@link IllegalArgumentException}. Creating
+     * a peer connection fails if the port is already in use. Set to 0 to
+     * bind a separate port per connection.
+     */
+    public int sharedUdpPort = 0;
+
+    /**
+     * Network interfaces to gather candidates on. Entries are interface
+     * names, optionally ending with a {@code *} wildcard (e.g. {@code eth*}),
+     * or CIDR blocks (e.g. {@code 10.0.0.0/8}). An empty list allows all
+     * interfaces. Malformed entries of both lists are rejected with an
+     * {@link IllegalArgumentException} when the configuration is used.
+     */
+    public List<String> interfaceAllowList = new ArrayList<>();
+
+    /**
+     * Network interfaces to never gather candidates on, e.g. {@code docker*}
+     * or {@code 172.17.0.0/16}. Takes precedence over the allow list.
+     */
+    public List<String> interfaceDenyList = new ArrayList<>();
+
+    /**
+     * Bitwise OR of the {@code NETWORK_*} types to ignore. Default is 0.
+     */
+    public int networkIgnoreMask = 0;
+
+    /**
+     * Ignores all IPv6 networks, regardless of the IPv6 allocator flags.
+     */
+    public boolean disableIpv6 = false;
+
+    /**
+     * Maximum number of networks, i.e. address prefixes, used per interface.
+     * The most preferred networks are kept. Set to 0 for no limit.
+     */
+    public int maxNetworksPerInterface = 0;
+
 
     /**
      * Creates an instance with default values.
@@ -84,6 +137,23 @@ public class PortAllocatorConfig {
         this.flags = flags;
     }
 
+    /**
+     * Creates a deep copy of this configuration.
+     *
+     * @return A new PortAllocatorConfig with the same values.
+     */
+    PortAllocatorConfig copy() {
+        PortAllocatorConfig copy = new PortAllocatorConfig(minPort, maxPort, flags);
+        copy.sharedUdpPort = sharedUdpPort;
+        copy.interfaceAllowList = interfaceAllowList == null ? null : new ArrayList<>(interfaceAllowList);
+        copy.interfaceDenyList = interfaceDenyList == null ? null : new ArrayList<>(interfaceDenyList);
+        copy.networkIgnoreMask = networkIgnoreMask;
+        copy.disableIpv6 = disableIpv6;
+        copy.maxNetworksPerInterface = maxNetworksPerInterface;
+
+        return copy;
+    }
+
     /**
      * Enable a flag.
      *
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import dev.kastle.webrtc.internal.RefCountedObject;
+
+/**
+ * A DTLS certificate held in native memory. Unlike {@link RTCCertificatePEM}
+ * it can be passed to any number of peer connections through {@link
+ * RTCConfiguration#nativeCertificates} without being parsed again.
+ * <p>
+ * Call {@link #release()} when no more peer connections are created with
+ * this certificate. Peer connections already using it keep their own
+ * references and are not affected.
+ *
+ * @author Alex Andres
+ */
+public class RTCCertificate extends RefCountedObject {
+
+	/**
+	 * Constructor used by the native api.
+	 */
+	private RTCCertificate() {
+
+	}
+
+	/**
+	 * @return The expiration time in milliseconds of this certificate relative
+	 * to the Unix epoch.
+	 */
+	public native long getExpires();
+
+	/**
+	 * Exports the private key and certificate as PEM strings.
+	 *
+	 * @return The PEM representation of this certificate.
+	 */
+	public native RTCCertificatePEM toPEM();
+
+}
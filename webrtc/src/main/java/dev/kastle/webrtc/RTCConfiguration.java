@@ -28,6 +28,12 @@ import java.util.List;
  */
 public class RTCConfiguration {
 
+	/**
+	 * {@link #iceCandidateBatchWindow} value to deliver all candidates once
+	 * gathering completes.
+	 */
+	public static final int ICE_CANDIDATE_BATCH_UNTIL_COMPLETE = -1;
+
 	/**
 	 * A list of ICE server's describing servers available to be used by ICE,
 	 * such as STUN and TURN servers.
@@ -58,12 +64,55 @@ public class RTCConfiguration {
 	 */
 	public List<RTCCertificatePEM> certificates;
 
+	/**
+	 * Pre-generated native certificates, used in addition to {@link
+	 * #certificates}. Sharing them avoids generating or parsing a certificate
+	 * for each RTCPeerConnection.
+	 */
+	public List<RTCCertificate> nativeCertificates;
+
 	/**
 	 * Port allocator configuration for controlling candidate port ranges and
 	 * transport behavior.
 	 */
 	public PortAllocatorConfig portAllocatorConfig;
 
+	/**
+	 * The number of ICE candidate sets gathered ahead of time, before the
+	 * first local description is set. Pre-gathered candidates shorten the
+	 * connection setup. Default is 0.
+	 */
+	public int iceCandidatePoolSize;
+
+	/**
+	 * Runs the RTCPeerConnection as an ICE-lite agent, intended for servers
+	 * with a public address. Only host UDP candidates are gathered, once, and
+	 * ICE servers are ignored. Local session descriptions announce
+	 * {@code a=ice-lite}, so that the full ICE agent of the remote peer takes
+	 * the controlling role. The lite peer should therefore be the answerer.
+	 */
+	public boolean iceLite;
+
+	/**
+	 * Coalesces gathered ICE candidates into {@link
+	 * PeerConnectionObserver#onIceCandidates} calls. A positive value is the
+	 * time in milliseconds candidates are collected after the first one of a
+	 * batch, {@link #ICE_CANDIDATE_BATCH_UNTIL_COMPLETE} collects them until
+	 * gathering completes. Pending candidates are always delivered before a
+	 * gathering or connection state change and when the connection is closed.
+	 * Default is 0, each candidate is
+	 * delivered on its own. Applied when the RTCPeerConnection is created.
+	 */
+	public int iceCandidateBatchWindow;
+
+	/**
+	 * Writes and parses the SDP of data channel only sessions from a fixed
+	 * template, instead of running the generic serializer and parser.
+	 * Descriptions that do not match the template, e.g. with media sections
+	 * or unknown attributes, are still handled by the generic implementation.
+	 * Default is false. Applied when the RTCPeerConnection is created.
+	 */
+	public boolean sdpTemplate;
 
 	/**
 	 * Creates an instance of RTCConfiguration.
@@ -74,7 +123,43 @@ public class RTCConfiguration {
 		bundlePolicy = RTCBundlePolicy.BALANCED;
 		rtcpMuxPolicy = RTCRtcpMuxPolicy.REQUIRE;
 		certificates = new ArrayList<>();
+		nativeCertificates = new ArrayList<>();
 		portAllocatorConfig = new PortAllocatorConfig();
+		iceCandidatePoolSize = 0;
+		iceLite = false;
+		iceCandidateBatchWindow = 0;
+		sdpTemplate = false;
+	}
+
+	/**
+	 * Creates a deep copy of this configuration. Certificates are immutable
+	 * or native objects and are shared with the copy.
+	 *
+	 * @return A new configuration with the same values.
+	 */
+	RTCConfiguration copy() {
+		RTCConfiguration copy = new RTCConfiguration();
+		copy.iceTransportPolicy = iceTransportPolicy;
+		copy.bundlePolicy = bundlePolicy;
+		copy.rtcpMuxPolicy = rtcpMuxPolicy;
+		copy.certificates = certificates == null ? null : new ArrayList<>(certificates);
+		copy.nativeCertificates = nativeCertificates == null ? null : new ArrayList<>(nativeCertificates);
+		copy.portAllocatorConfig = portAllocatorConfig == null ? null : portAllocatorConfig.copy();
+		copy.iceCandidatePoolSize = iceCandidatePoolSize;
+		copy.iceLite = iceLite;
+		copy.iceCandidateBatchWindow = iceCandidateBatchWindow;
+		copy.sdpTemplate = sdpTemplate;
+
+		if (iceServers == null) {
+			copy.iceServers = null;
+		}
+		else {
+			for (RTCIceServer server : iceServers) {
+				copy.iceServers.add(server == null ? null : server.copy());
+			}
+		}
+
+		return copy;
 	}
 
 }
@@ -19,6 +19,7 @@ package dev.kastle.webrtc;
 import dev.kastle.webrtc.internal.DisposableNativeObject;
 
 import java.nio.ByteBuffer;
+import java.util.concurrent.CompletableFuture;
 
 /**
  * Represents a bidirectional data channel between two peers. An RTCDataChannel
@@ -28,11 +29,61 @@ import java.nio.ByteBuffer;
  */
 public class RTCDataChannel extends DisposableNativeObject {
 
+	/**
+	 * Index of the number of sent messages in the array filled by {@link
+	 * #getCounters(long[])}.
+	 */
+	public static final int COUNTER_MESSAGES_SENT = 0;
+
+	/**
+	 * Index of the number of received messages in the array filled by {@link
+	 * #getCounters(long[])}.
+	 */
+	public static final int COUNTER_MESSAGES_RECEIVED = 1;
+
+	/**
+	 * Index of the number of sent payload bytes in the array filled by {@link
+	 * #getCounters(long[])}.
+	 */
+	public static final int COUNTER_BYTES_SENT = 2;
+
+	/**
+	 * Index of the number of received payload bytes in the array filled by
+	 * {@link #getCounters(long[])}.
+	 */
+	public static final int COUNTER_BYTES_RECEIVED = 3;
+
+	/**
+	 * The number of values written by {@link #getCounters(long[])}.
+	 */
+	public static final int COUNTER_COUNT = 4;
+
+	/**
+	 * Native counters maintained by this wrapper and the registered observer.
+	 */
+	private long countersHandle;
+
+	/**
+	 * Native state of {@link #closeWhenDrained(long)}, shared by all observers.
+	 */
+	private long drainHandle;
+
+	/**
+	 * The native observer of the last registered RTCDataChannelObserver.
+	 */
+	private long observerHandle;
+
+	/**
+	 * The signaling thread of the peer connection owning this channel.
+	 */
+	private long signalingThreadHandle;
+
+
 	/**
 	 * Used by the native api.
 	 */
 	private RTCDataChannel() {
-
+		initialize();
 	}
 
 	/**
@@ -133,12 +184,59 @@ public class RTCDataChannel extends DisposableNativeObject {
 	 */
 	public native long getBufferedAmount();
 
+	/**
+	 * Copies the message and byte counters of this RTCDataChannel into the
+	 * provided array, using the {@code COUNTER_*} constants as indices. The
+	 * counters are maintained natively by this wrapper, so this call neither
+	 * allocates nor waits for any WebRTC thread and is cheap enough to be
+	 * polled frequently.
+	 * <p>
+	 * Sent messages are counted when they have been successfully queued via
+	 * {@link #send(RTCDataChannelBuffer)}. Received messages are counted when
+	 * they are delivered to the registered {@link RTCDataChannelObserver}.
+	 *
+	 * @param out The array to fill, with a length of at least {@link
+	 *            #COUNTER_COUNT}.
+	 */
+	public native void getCounters(long[] out);
+
 	/**
 	 * Closes this RTCDataChannel. It may be called regardless of whether the
 	 * RTCDataChannel was created by this peer or the remote peer.
 	 */
 	public native void close();
 
+	/**
+	 * Closes this RTCDataChannel once all data queued via {@link
+	 * #send(RTCDataChannelBuffer)} has been handed to the transport, or once
+	 * the timeout has elapsed, whichever happens first. The buffered amount is
+	 * watched natively on the signaling thread, so no Java thread is blocked or
+	 * polling while the channel drains.
+	 * <p>
+	 * Observers may be registered or replaced while the channel is draining.
+	 * Disposing the channel before it has drained completes the returned
+	 * future exceptionally, as does calling this method again while a previous
+	 * drain is still pending.
+	 *
+	 * @param timeoutMs The maximum time in milliseconds to wait for the
+	 *                  buffer to drain.
+	 *
+	 * @return A future completed with {@code true} if the buffer was drained
+	 * before the channel was closed, or {@code false} if the timeout elapsed
+	 * first.
+	 */
+	public CompletableFuture<Boolean> closeWhenDrained(long timeoutMs) {
+		if (timeoutMs < 0) {
+			throw new IllegalArgumentException("Timeout must not be negative");
+		}
+
+		CompletableFuture<Boolean> future = new CompletableFuture<>();
+
+		closeWhenDrainedFuture(timeoutMs, future);
+
+		return future;
+	}
+
 	@Override
 	public native void dispose();
 
@@ -175,4 +273,9 @@ public class RTCDataChannel extends DisposableNativeObject {
 
 	private native void sendByteArrayBuffer(byte[] buffer, boolean binary);
 
+	private native void closeWhenDrainedFuture(long timeoutMs,
+			CompletableFuture<Boolean> future);
+
+	private native void initialize();
+
 }
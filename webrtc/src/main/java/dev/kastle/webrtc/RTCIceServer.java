@@ -81,6 +81,24 @@ public class RTCIceServer {
 		tlsCertPolicy = TlsCertPolicy.SECURE;
 	}
 
+	/**
+	 * Creates a deep copy of this server description.
+	 *
+	 * @return A new RTCIceServer with the same values.
+	 */
+	RTCIceServer copy() {
+		RTCIceServer copy = new RTCIceServer();
+		copy.urls = urls == null ? null : new ArrayList<>(urls);
+		copy.username = username;
+		copy.password = password;
+		copy.tlsCertPolicy = tlsCertPolicy;
+		copy.hostname = hostname;
+		copy.tlsAlpnProtocols = tlsAlpnProtocols == null ? null : new ArrayList<>(tlsAlpnProtocols);
+		copy.tlsEllipticCurves = tlsEllipticCurves == null ? null : new ArrayList<>(tlsEllipticCurves);
+
+		return copy;
+	}
+
 	@Override
 	public int hashCode() {
 		return Objects.hash(hostname, password, tlsAlpnProtocols, tlsCertPolicy,
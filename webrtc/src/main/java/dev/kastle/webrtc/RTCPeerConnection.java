@@ -16,8 +16,13 @@
 
 package dev.kastle.webrtc;
 
+import static java.util.Objects.requireNonNull;
+
 import dev.kastle.webrtc.internal.NativeObject;
 
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executor;
+
 /**
  * The RTCPeerConnection represents a WebRTC connection between the local
  * computer and a remote peer. Communications are coordinated by the exchange of
@@ -33,6 +38,41 @@ public class RTCPeerConnection extends NativeObject {
 	 */
 	private long observerHandle;
 
+	/**
+	 * Load counter of the factory shard this PeerConnection was placed on.
+	 * Released when the PeerConnection is closed.
+	 */
+	private long shardLoadHandle;
+
+	/**
+	 * Signaling thread of the factory shard this PeerConnection was placed on.
+	 */
+	private long signalingThreadHandle;
+
+	/**
+	 * Options that are applied when this PeerConnection is created and cannot
+	 * be changed afterwards, e.g. ICE-lite and the shared UDP port. Released
+	 * when the PeerConnection is closed.
+	 */
+	private long optionsHandle;
+
+	/**
+	 * Snapshot copied by {@link #getConfiguration()}, invalidated by
+	 * {@link #setConfiguration(RTCConfiguration)} and on close.
+	 */
+	private RTCConfiguration configuration;
+
+	/**
+	 * Incremented on each invalidation, so that a snapshot queried
+	 * concurrently with an update is not cached.
+	 */
+	private long configurationVersion;
+
+	/**
+	 * Guards the snapshot, never held across native calls.
+	 */
+	private final Object configurationLock = new Object();
+
 
 	/**
 	 * Constructor used by the native api.
@@ -55,6 +95,43 @@ public class RTCPeerConnection extends NativeObject {
 	public native RTCDataChannel createDataChannel(String label,
 			RTCDataChannelInit dict);
 
+	/**
+	 * Creates several data channels in one native call and one task on the
+	 * signaling thread. Either one dictionary is given for each label, or a
+	 * single dictionary that is used for all channels. If a channel cannot be
+	 * created, the channels already created by this call are closed.
+	 *
+	 * @param labels Human-readable names of the channels.
+	 * @param dicts  The configuration options of the data channels.
+	 *
+	 * @return The new data channels in the order of the labels.
+	 */
+	public RTCDataChannel[] createDataChannels(String[] labels,
+			RTCDataChannelInit[] dicts) {
+		checkDataChannelArrays(labels, dicts);
+
+		return createDataChannelsInit(labels, dicts);
+	}
+
+	/**
+	 * Creates several data channels like {@link
+	 * #createDataChannels(String[], RTCDataChannelInit[])} from precompiled
+	 * dictionaries, which avoids converting the dictionaries on each call.
+	 *
+	 * @param labels Human-readable names of the channels.
+	 * @param dicts  The compiled configuration options of the data channels.
+	 *
+	 * @return The new data channels in the order of the labels.
+	 *
+	 * @see PeerConnectionFactory#compileDataChannelInit(RTCDataChannelInit)
+	 */
+	public RTCDataChannel[] createDataChannels(String[] labels,
+			CompiledRTCDataChannelInit[] dicts) {
+		checkDataChannelArrays(labels, dicts);
+
+		return createDataChannelsCompiled(labels, dicts);
+	}
+
 	/**
 	 * Initiates the creation of an SDP that contains an RFC 3264 offer with the
 	 * supported configurations for the session, the
@@ -82,6 +159,31 @@ public class RTCPeerConnection extends NativeObject {
 	public native void createAnswer(RTCAnswerOptions options,
 			CreateSessionDescriptionObserver observer);
 
+	/**
+	 * Creates an offer and sets it as the local description in a single call.
+	 * Both steps run on the signaling thread without returning to Java in
+	 * between.
+	 *
+	 * @param options  The options to provide additional control over the
+	 *                 offer.
+	 * @param callback The callback to obtain the SDP of the applied offer.
+	 */
+	public native void createAndSetLocalOffer(RTCOfferOptions options,
+			NegotiationCallback callback);
+
+	/**
+	 * Sets the remote offer, creates an answer and sets it as the local
+	 * description in a single call. All steps run on the signaling thread
+	 * without returning to Java in between.
+	 *
+	 * @param sdp      The SDP of the remote offer.
+	 * @param options  The options to provide additional control over the
+	 *                 answer.
+	 * @param callback The callback to obtain the SDP of the applied answer.
+	 */
+	public native void answerRemoteOffer(String sdp, RTCAnswerOptions options,
+			NegotiationCallback callback);
+
 	/**
 	 * Returns the local description that was successfully negotiated the last
 	 * time the RTCPeerConnection transitioned into the stable state plus any
@@ -172,6 +274,58 @@ public class RTCPeerConnection extends NativeObject {
 	 */
 	public native void addIceCandidate(RTCIceCandidate candidate);
 
+	/**
+	 * Adds remote ICE candidates to the ICE Agent. All candidates are parsed
+	 * in one native call and added in one task on the signaling thread.
+	 * Candidates that fail to parse or to be added do not affect the others.
+	 *
+	 * @param candidates New ICE candidates received from the remote peer over
+	 *                   a signaling channel.
+	 *
+	 * @return A future completed with one entry per candidate, {@code null} if
+	 * the candidate was added, otherwise the error message.
+	 */
+	public CompletableFuture<String[]> addIceCandidates(
+			RTCIceCandidate[] candidates) {
+		requireNonNull(candidates, "RTCIceCandidate array must not be null");
+
+		CompletableFuture<String[]> future = new CompletableFuture<>();
+
+		addIceCandidatesFuture(candidates, future);
+
+		return future;
+	}
+
+	/**
+	 * Adds remote ICE candidates like {@link
+	 * #addIceCandidates(RTCIceCandidate[])}, given as parallel arrays as they
+	 * arrive from a signaling channel, without creating {@link
+	 * RTCIceCandidate} objects.
+	 *
+	 * @param sdpMids         The media stream identification tags.
+	 * @param sdpMLineIndices The indices of the m-lines.
+	 * @param sdps            The candidate-attribute strings.
+	 *
+	 * @return A future completed with one entry per candidate, {@code null} if
+	 * the candidate was added, otherwise the error message.
+	 */
+	public CompletableFuture<String[]> addIceCandidates(String[] sdpMids,
+			int[] sdpMLineIndices, String[] sdps) {
+		requireNonNull(sdpMids, "SDP mid array must not be null");
+		requireNonNull(sdpMLineIndices, "SDP m-line index array must not be null");
+		requireNonNull(sdps, "SDP array must not be null");
+
+		if (sdpMids.length != sdps.length || sdpMLineIndices.length != sdps.length) {
+			throw new IllegalArgumentException("ICE candidate arrays differ in length");
+		}
+
+		CompletableFuture<String[]> future = new CompletableFuture<>();
+
+		addIceCandidatesRaw(sdpMids, sdpMLineIndices, sdps, future);
+
+		return future;
+	}
+
 	/**
 	 * Removes a group of remote ICE candidates from the ICE agent.
 	 *
@@ -210,21 +364,64 @@ public class RTCPeerConnection extends NativeObject {
 	/**
 	 * Returns an RTCConfiguration object representing the current configuration
 	 * of this RTCPeerConnection.
+	 * <p>
+	 * The configuration is converted once and cached until {@link
+	 * #setConfiguration(RTCConfiguration)} or {@link #close()} is called.
+	 * Each call returns a new copy of the cached snapshot, changes to the
+	 * returned object take effect only when passed to {@code
+	 * setConfiguration}.
 	 *
 	 * @return The configuration that indicates the current configuration of
 	 * this RTCPeerConnection.
 	 */
-	public native RTCConfiguration getConfiguration();
+	public RTCConfiguration getConfiguration() {
+		RTCConfiguration snapshot;
+		long version;
+
+		synchronized (configurationLock) {
+			snapshot = configuration;
+			version = configurationVersion;
+		}
+
+		if (snapshot == null) {
+			snapshot = queryConfiguration();
+
+			synchronized (configurationLock) {
+				if (version == configurationVersion) {
+					configuration = snapshot;
+				}
+			}
+		}
+
+		return snapshot.copy();
+	}
 
 	/**
 	 * Updates the configuration of this RTCPeerConnection. This includes
 	 * changing the configuration of the ICE Agent. When the ICE configuration
 	 * changes in a way that requires a new gathering phase, an ICE restart is
 	 * required.
+	 * <p>
+	 * {@link RTCConfiguration#iceLite}, {@link
+	 * RTCConfiguration#iceCandidateBatchWindow}, {@link
+	 * RTCConfiguration#sdpTemplate}, the shared UDP port and the network
+	 * filter of the {@link PortAllocatorConfig} must be the same as when this
+	 * RTCPeerConnection was created.
 	 *
 	 * @param configuration The new configuration.
+	 *
+	 * @throws RuntimeException If the configuration cannot be applied or an
+	 *                          option that is only applied on creation has
+	 *                          changed.
 	 */
-	public native void setConfiguration(RTCConfiguration configuration);
+	public void setConfiguration(RTCConfiguration configuration) {
+		try {
+			applyConfiguration(configuration);
+		}
+		finally {
+			invalidateConfiguration();
+		}
+	}
 
 	/**
 	 * Gathers the current statistics of this RTCPeerConnection.
@@ -233,6 +430,190 @@ public class RTCPeerConnection extends NativeObject {
 	 */
 	public native void getStats(RTCStatsCollectorCallback callback);
 
+	/**
+	 * Gathers the current statistics of this RTCPeerConnection and delivers
+	 * them serialized in the given format. Unlike {@link
+	 * #getStats(RTCStatsCollectorCallback)} no Java objects are created for
+	 * the individual stats, which makes this suitable for forwarding reports
+	 * to export pipelines.
+	 *
+	 * @param format   The encoding of the serialized stats report.
+	 * @param callback The callback to receive the serialized stats.
+	 */
+	public native void getStatsSerialized(RTCStatsFormat format,
+			RTCStatsSerializedCallback callback);
+
+	/**
+	 * Creates an offer like {@link #createOffer createOffer}. The returned
+	 * future is completed by the native api on the signaling thread.
+	 *
+	 * @param options The options to provide additional control over the
+	 *                offer.
+	 *
+	 * @return A future completed with the created offer.
+	 */
+	public CompletableFuture<RTCSessionDescription> createOfferAsync(
+			RTCOfferOptions options) {
+		CompletableFuture<RTCSessionDescription> future = new CompletableFuture<>();
+
+		createOfferFuture(options, future);
+
+		return future;
+	}
+
+	/**
+	 * Creates an offer like {@link #createOfferAsync(RTCOfferOptions)} and
+	 * completes the returned future on the given executor.
+	 *
+	 * @param options  The options to provide additional control over the
+	 *                 offer.
+	 * @param executor The executor to complete the future on.
+	 *
+	 * @return A future completed with the created offer.
+	 */
+	public CompletableFuture<RTCSessionDescription> createOfferAsync(
+			RTCOfferOptions options, Executor executor) {
+		requireNonNull(executor, "Executor must not be null");
+
+		return completeOn(createOfferAsync(options), executor);
+	}
+
+	/**
+	 * Creates an answer like {@link #createAnswer createAnswer}. The returned
+	 * future is completed by the native api on the signaling thread.
+	 *
+	 * @param options The options to provide additional control over the
+	 *                answer.
+	 *
+	 * @return A future completed with the created answer.
+	 */
+	public CompletableFuture<RTCSessionDescription> createAnswerAsync(
+			RTCAnswerOptions options) {
+		CompletableFuture<RTCSessionDescription> future = new CompletableFuture<>();
+
+		createAnswerFuture(options, future);
+
+		return future;
+	}
+
+	/**
+	 * Creates an answer like {@link #createAnswerAsync(RTCAnswerOptions)} and
+	 * completes the returned future on the given executor.
+	 *
+	 * @param options  The options to provide additional control over the
+	 *                 answer.
+	 * @param executor The executor to complete the future on.
+	 *
+	 * @return A future completed with the created answer.
+	 */
+	public CompletableFuture<RTCSessionDescription> createAnswerAsync(
+			RTCAnswerOptions options, Executor executor) {
+		requireNonNull(executor, "Executor must not be null");
+
+		return completeOn(createAnswerAsync(options), executor);
+	}
+
+	/**
+	 * Applies the local description like {@link #setLocalDescription
+	 * setLocalDescription}. The returned future is completed by the native
+	 * api on the signaling thread.
+	 *
+	 * @param description The description to apply to the local end of the
+	 *                    connection.
+	 *
+	 * @return A future completed once the description has been applied.
+	 */
+	public CompletableFuture<Void> setLocalDescriptionAsync(
+			RTCSessionDescription description) {
+		CompletableFuture<Void> future = new CompletableFuture<>();
+
+		setLocalDescriptionFuture(description, future);
+
+		return future;
+	}
+
+	/**
+	 * Applies the local description like {@link
+	 * #setLocalDescriptionAsync(RTCSessionDescription)} and completes the
+	 * returned future on the given executor.
+	 *
+	 * @param description The description to apply to the local end of the
+	 *                    connection.
+	 * @param executor    The executor to complete the future on.
+	 *
+	 * @return A future completed once the description has been applied.
+	 */
+	public CompletableFuture<Void> setLocalDescriptionAsync(
+			RTCSessionDescription description, Executor executor) {
+		requireNonNull(executor, "Executor must not be null");
+
+		return completeOn(setLocalDescriptionAsync(description), executor);
+	}
+
+	/**
+	 * Applies the remote description like {@link #setRemoteDescription
+	 * setRemoteDescription}. The returned future is completed by the native
+	 * api on the signaling thread.
+	 *
+	 * @param description The remote peer's current offer or answer.
+	 *
+	 * @return A future completed once the description has been applied.
+	 */
+	public CompletableFuture<Void> setRemoteDescriptionAsync(
+			RTCSessionDescription description) {
+		CompletableFuture<Void> future = new CompletableFuture<>();
+
+		setRemoteDescriptionFuture(description, future);
+
+		return future;
+	}
+
+	/**
+	 * Applies the remote description like {@link
+	 * #setRemoteDescriptionAsync(RTCSessionDescription)} and completes the
+	 * returned future on the given executor.
+	 *
+	 * @param description The remote peer's current offer or answer.
+	 * @param executor    The executor to complete the future on.
+	 *
+	 * @return A future completed once the description has been applied.
+	 */
+	public CompletableFuture<Void> setRemoteDescriptionAsync(
+			RTCSessionDescription description, Executor executor) {
+		requireNonNull(executor, "Executor must not be null");
+
+		return completeOn(setRemoteDescriptionAsync(description), executor);
+	}
+
+	/**
+	 * Gathers the current statistics like {@link
+	 * #getStats(RTCStatsCollectorCallback)}. The returned future is completed
+	 * by the native api.
+	 *
+	 * @return A future completed with the stats report.
+	 */
+	public CompletableFuture<RTCStatsReport> getStatsAsync() {
+		CompletableFuture<RTCStatsReport> future = new CompletableFuture<>();
+
+		getStatsFuture(future);
+
+		return future;
+	}
+
+	/**
+	 * Gathers the current statistics like {@link #getStatsAsync()} and
+	 * completes the returned future on the given executor.
+	 *
+	 * @param executor The executor to complete the future on.
+	 *
+	 * @return A future completed with the stats report.
+	 */
+	public CompletableFuture<RTCStatsReport> getStatsAsync(Executor executor) {
+		requireNonNull(executor, "Executor must not be null");
+
+		return completeOn(getStatsAsync(), executor);
+	}
+
 	/**
 	 * Tells the RTCPeerConnection that ICE should be restarted. Subsequent
 	 * calls to {@code createOffer} will create descriptions that will restart
@@ -244,6 +625,118 @@ public class RTCPeerConnection extends NativeObject {
 	 * Closes the peer connection, terminates all media and releases any used
 	 * resources.
 	 */
-	public native void close();
+	public void close() {
+		invalidateConfiguration();
+
+		closeConnection();
+	}
+
+	/**
+	 * Closes the peer connection like {@link #close()} without blocking the
+	 * calling thread. The connection behaves as closed as soon as this method
+	 * returns, while the transports are torn down on the signaling thread.
+	 *
+	 * @return A future completed once the peer connection is closed.
+	 *
+	 * @see PeerConnectionFactory#closeAll(java.util.Collection)
+	 */
+	public CompletableFuture<Void> closeAsync() {
+		CompletableFuture<Void> future = new CompletableFuture<>();
+
+		invalidateConfiguration();
+		closeFuture(future);
+
+		return future;
+	}
+
+	static CompletableFuture<Void> closeAll(RTCPeerConnection[] connections) {
+		CompletableFuture<Void> future = new CompletableFuture<>();
+
+		for (RTCPeerConnection connection : connections) {
+			if (connection != null) {
+				connection.invalidateConfiguration();
+			}
+		}
+
+		closeAll(connections, future);
+
+		return future;
+	}
+
+	private void invalidateConfiguration() {
+		synchronized (configurationLock) {
+			configuration = null;
+			configurationVersion++;
+		}
+	}
+
+	private native void createOfferFuture(RTCOfferOptions options,
+			CompletableFuture<RTCSessionDescription> future);
+
+	private native void createAnswerFuture(RTCAnswerOptions options,
+			CompletableFuture<RTCSessionDescription> future);
+
+	private native void setLocalDescriptionFuture(
+			RTCSessionDescription description, CompletableFuture<Void> future);
+
+	private native void setRemoteDescriptionFuture(
+			RTCSessionDescription description, CompletableFuture<Void> future);
+
+	private native void getStatsFuture(CompletableFuture<RTCStatsReport> future);
+
+	private native void addIceCandidatesFuture(RTCIceCandidate[] candidates,
+			CompletableFuture<String[]> future);
+
+	private native void addIceCandidatesRaw(String[] sdpMids,
+			int[] sdpMLineIndices, String[] sdps,
+			CompletableFuture<String[]> future);
+
+	private native RTCDataChannel[] createDataChannelsInit(String[] labels,
+			RTCDataChannelInit[] dicts);
+
+	private native RTCDataChannel[] createDataChannelsCompiled(String[] labels,
+			CompiledRTCDataChannelInit[] dicts);
+
+	private native void closeConnection();
+
+	private native void closeFuture(CompletableFuture<Void> future);
+
+	private static native void closeAll(RTCPeerConnection[] connections,
+			CompletableFuture<Void> future);
+
+	private native RTCConfiguration queryConfiguration();
+
+	private native void applyConfiguration(RTCConfiguration configuration);
+
+	private static void checkDataChannelArrays(String[] labels,
+			Object[] dicts) {
+		requireNonNull(labels, "Label array must not be null");
+		requireNonNull(dicts, "RTCDataChannelInit array must not be null");
+
+		if (dicts.length != 1 && dicts.length != labels.length) {
+			throw new IllegalArgumentException(
+					"Expected one RTCDataChannelInit or one for each label");
+		}
+	}
+
+	/**
+	 * Completes the returned future on the executor, regardless of whether the
+	 * source future completed normally or exceptionally.
+	 */
+	private static <T> CompletableFuture<T> completeOn(
+			CompletableFuture<T> source, Executor executor) {
+		CompletableFuture<T> future = new CompletableFuture<>();
+
+		source.whenCompleteAsync((value, error) -> {
+			if (error != null) {
+				future.completeExceptionally(error);
+			}
+			else {
+				future.complete(value);
+			}
+		}, executor);
+
+		return future;
+	}
 
 }
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * The encoding of a stats report delivered to a {@link
+ * RTCStatsSerializedCallback}.
+ *
+ * @author Alex Andres
+ */
+public enum RTCStatsFormat {
+
+	/**
+	 * The JSON representation produced by the native stats report. The
+	 * report is encoded as a UTF-8 JSON array of stats objects.
+	 */
+	JSON,
+
+	/**
+	 * A compact little-endian binary encoding. Strings are encoded as an
+	 * unsigned 32-bit byte length followed by UTF-8 bytes. The layout is:
+	 * <pre>
+	 * report     := int64 timestamp_us, uint32 stats_count, stats*
+	 * stats      := string id, string type, int64 timestamp_us,
+	 *               uint32 attribute_count, attribute*
+	 * attribute  := string name, uint8 tag, value
+	 * </pre>
+	 * The tag selects the value encoding:
+	 * <pre>
+	 *  0 bool (uint8)       8 int32[]
+	 *  1 int32              9 uint32[]
+	 *  2 uint32            10 int64[]
+	 *  3 int64             11 uint64[]
+	 *  4 uint64            12 double[]
+	 *  5 double            13 string[]
+	 *  6 string            14 map&lt;string, uint64&gt;
+	 *  7 bool[]            15 map&lt;string, double&gt;
+	 * </pre>
+	 * Sequences and maps are prefixed with an uint32 element count. Map
+	 * entries are encoded as a string key followed by the value.
+	 */
+	BINARY
+
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * An RTCStatsSerializedCallback reports back when a stats report has been
+ * generated and serialized natively, without creating an {@link
+ * RTCStatsReport}.
+ *
+ * @author Alex Andres
+ */
+public interface RTCStatsSerializedCallback {
+
+	/**
+	 * All necessary statistics have been gathered and the stats report has
+	 * been serialized.
+	 *
+	 * @param data The serialized stats report in the requested {@link
+	 *             RTCStatsFormat}.
+	 */
+	void onStatsDelivered(byte[] data);
+
+}
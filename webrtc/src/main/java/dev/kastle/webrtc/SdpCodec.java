@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import dev.kastle.webrtc.internal.NativeLoader;
+
+/**
+ * Compact binary encoding of data channel session descriptions and ICE
+ * candidates for the signaling channel. A typical data channel SDP of about
+ * a kilobyte encodes to roughly a tenth of its size, while keeping every
+ * field a data channel session needs: ICE credentials and options, the DTLS
+ * fingerprint and role, the SCTP port, the maximum message size and the
+ * candidates. Decoding rebuilds an equivalent SDP that can be applied with
+ * {@link RTCPeerConnection#setRemoteDescription}.
+ * <p>
+ * All integers are big-endian. Strings and byte strings are prefixed with a
+ * one byte length, long strings with a two byte length. Tokens are a one byte index into a table of well-known
+ * values, or {@code 0xFF} followed by a string. A description is encoded as:
+ * <pre>
+ * u8      version (2)
+ * u8      type (0 = offer, 1 = pranswer, 2 = answer)
+ * u64     session id
+ * u64     session version
+ * u8      flags (bit 0 = ice-lite, bit 1 = trickle)
+ * string  mid
+ * lstring ice-ufrag
+ * lstring ice-pwd
+ * u8      DTLS setup (0 = none, 1 = active, 2 = passive, 3 = actpass)
+ * token   fingerprint algorithm (sha-256, sha-384, sha-512, sha-1)
+ * bytes   fingerprint digest
+ * u16     SCTP port
+ * u32     maximum message size
+ * u16     candidate count, followed by the candidates
+ * </pre>
+ * A candidate is encoded as:
+ * <pre>
+ * u8      component
+ * token   protocol (udp, tcp, ssltcp, tls)
+ * u8      type (0 = host, 1 = srflx, 2 = prflx, 3 = relay)
+ * u32     priority
+ * string  foundation
+ * lstring username fragment
+ * address connection address
+ * u8      related address present, followed by the related address
+ * token   TCP type (none, active, passive, so)
+ * u32     generation
+ * u16     network id
+ * u16     network cost
+ * </pre>
+ * An address is a kind byte (4 = IPv4, 6 = IPv6, 0 = hostname), the raw
+ * address bytes or the hostname string, and a u16 port. A candidate array
+ * starts with a u8 version and a u16 count, and each candidate is preceded by
+ * its mid string and a u16 m-line index.
+ * <p>
+ * Only sessions with a single bundled data channel section and numeric
+ * session id and version can be encoded.
+ * Malformed or truncated input is rejected with an error.
+ *
+ * @author Alex Andres
+ */
+public final class SdpCodec {
+
+	static {
+		try {
+			NativeLoader.loadLibrary("webrtc-java");
+		}
+		catch (Exception e) {
+			throw new RuntimeException("Load library 'webrtc-java' failed", e);
+		}
+	}
+
+
+	private SdpCodec() {
+
+	}
+
+	/**
+	 * Encodes a data channel session description.
+	 *
+	 * @param description The session description to encode.
+	 *
+	 * @return The encoded session description.
+	 */
+	public static native byte[] encodeDescription(RTCSessionDescription description);
+
+	/**
+	 * Decodes a session description encoded with {@link #encodeDescription}.
+	 *
+	 * @param data The encoded session description.
+	 *
+	 * @return The decoded session description, including its candidates.
+	 */
+	public static native RTCSessionDescription decodeDescription(byte[] data);
+
+	/**
+	 * Encodes a batch of ICE candidates, e.g. the candidates received with
+	 * {@link PeerConnectionObserver#onIceCandidates}.
+	 *
+	 * @param candidates The ICE candidates to encode.
+	 *
+	 * @return The encoded candidates.
+	 */
+	public static native byte[] encodeCandidates(RTCIceCandidate[] candidates);
+
+	/**
+	 * Decodes ICE candidates encoded with {@link #encodeCandidates}.
+	 *
+	 * @param data The encoded candidates.
+	 *
+	 * @return The decoded ICE candidates.
+	 */
+	public static native RTCIceCandidate[] decodeCandidates(byte[] data);
+
+}
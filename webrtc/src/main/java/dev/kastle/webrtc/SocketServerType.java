@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+/**
+ * The socket server used by the network threads of a {@link
+ * PeerConnectionFactory}.
+ *
+ * @author Alex Andres
+ */
+public enum SocketServerType {
+
+	/**
+	 * The default WebRTC socket server, reading one datagram per poll.
+	 */
+	DEFAULT,
+
+	/**
+	 * A socket server that reads all pending datagrams of a UDP socket with a
+	 * single {@code recvmmsg} call and delivers them within the same network
+	 * thread wakeup. Only available on Linux, other platforms use the default
+	 * socket server.
+	 */
+	BATCHING;
+
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc.logging;
+
+/**
+ * A single WebRTC log message as delivered by {@link
+ * LogSink#onLogMessages(LogRecord[])}.
+ *
+ * @author Alex Andres
+ */
+public class LogRecord {
+
+	private final Logging.Severity severity;
+
+	private final long timestamp;
+
+	private final long threadId;
+
+	private final String message;
+
+
+	LogRecord(Logging.Severity severity, long timestamp, long threadId,
+			String message) {
+		this.severity = severity;
+		this.timestamp = timestamp;
+		this.threadId = threadId;
+		this.message = message;
+	}
+
+	/**
+	 * Returns the severity of the message.
+	 *
+	 * @return The message severity.
+	 */
+	public Logging.Severity getSeverity() {
+		return severity;
+	}
+
+	/**
+	 * Returns the time at which the message was logged.
+	 *
+	 * @return The time in milliseconds since the epoch.
+	 */
+	public long getTimestamp() {
+		return timestamp;
+	}
+
+	/**
+	 * Returns the id of the native thread that logged the message.
+	 *
+	 * @return The native thread id.
+	 */
+	public long getThreadId() {
+		return threadId;
+	}
+
+	/**
+	 * Returns the formatted log message.
+	 *
+	 * @return The log message.
+	 */
+	public String getMessage() {
+		return message;
+	}
+
+	@Override
+	public String toString() {
+		return String.format("%s@%d [severity=%s, timestamp=%d, threadId=%d, message=%s]",
+				LogRecord.class.getSimpleName(), hashCode(), severity,
+				timestamp, threadId, message);
+	}
+}
@@ -25,4 +25,16 @@ public interface LogSink {
 
 	void onLogMessage(Logging.Severity severity, String message);
 
+	/**
+	 * Receives a batch of log messages in the order in which they were logged.
+	 * By default each message is passed to {@link #onLogMessage}.
+	 *
+	 * @param records The logged messages.
+	 */
+	default void onLogMessages(LogRecord[] records) {
+		for (LogRecord record : records) {
+			onLogMessage(record.getSeverity(), record.getMessage());
+		}
+	}
+
 }
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc.logging;
+
+/**
+ * Configuration of a {@link LogSink} registered with {@link
+ * Logging#addLogSink(Logging.Severity, LogSink, LogSinkConfig)}.
+ * <p>
+ * WebRTC threads only filter and enqueue log messages into a native ring
+ * buffer. A dedicated native thread delivers the queued messages in batches
+ * to the sink, so that logging does not slow down the network thread.
+ * Messages filtered by severity, tag or rate never reach Java.
+ *
+ * @author Alex Andres
+ */
+public class LogSinkConfig {
+
+	/**
+	 * The number of messages the ring buffer can hold, rounded up to a power
+	 * of two. Messages logged while the buffer is full are dropped and
+	 * reported by a single warning with the number of dropped messages.
+	 */
+	public int capacity = 4096;
+
+	/**
+	 * The maximum time in milliseconds a message waits in the buffer before it
+	 * is delivered to the sink.
+	 */
+	public int flushInterval = 50;
+
+	/**
+	 * The maximum number of messages accepted per second, or 0 for no limit.
+	 * Messages above the limit are discarded silently.
+	 */
+	public int maxMessagesPerSecond = 0;
+
+	/**
+	 * Tags of messages that are discarded. The tag of a WebRTC log message is
+	 * the name of the source file that logged it, e.g. {@code "port.cc"}.
+	 */
+	public String[] excludedTags = new String[0];
+
+
+	/**
+	 * Creates an instance with default values.
+	 */
+	public LogSinkConfig() {
+	}
+
+}
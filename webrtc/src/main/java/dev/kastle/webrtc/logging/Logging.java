@@ -16,6 +16,8 @@
 
 package dev.kastle.webrtc.logging;
 
+import static java.util.Objects.requireNonNull;
+
 import java.io.PrintWriter;
 import java.io.StringWriter;
 
@@ -63,7 +65,50 @@ public class Logging {
 
 	}
 
-	public static native void addLogSink(Severity severity, LogSink sink);
+	/**
+	 * Registers a sink that receives all log messages with at least the given
+	 * severity, using the default {@link LogSinkConfig}.
+	 *
+	 * @param severity The minimum severity of messages to receive.
+	 * @param sink     The sink to register.
+	 */
+	public static void addLogSink(Severity severity, LogSink sink) {
+		addLogSink(severity, sink, new LogSinkConfig());
+	}
+
+	/**
+	 * Registers a sink that receives all log messages with at least the given
+	 * severity. Messages are buffered natively and delivered in batches on a
+	 * dedicated thread, see {@link LogSinkConfig}.
+	 *
+	 * @param severity The minimum severity of messages to receive.
+	 * @param sink     The sink to register.
+	 * @param config   The buffering and filter configuration.
+	 */
+	public static void addLogSink(Severity severity, LogSink sink,
+			LogSinkConfig config) {
+		requireNonNull(severity, "Severity must not be null");
+		requireNonNull(sink, "LogSink must not be null");
+		requireNonNull(config, "LogSinkConfig must not be null");
+
+		if (config.capacity < 1) {
+			throw new IllegalArgumentException("Capacity must be at least 1");
+		}
+		if (config.flushInterval < 1) {
+			throw new IllegalArgumentException("Flush interval must be at least 1 ms");
+		}
+
+		addLogSinkConfig(severity, sink, config);
+	}
+
+	/**
+	 * Unregisters a sink added with {@link #addLogSink}. Messages already
+	 * buffered for the sink are delivered before this method returns. Must not
+	 * be called from the sink itself.
+	 *
+	 * @param sink The sink to remove.
+	 */
+	public static native void removeLogSink(LogSink sink);
 
 	public static native void log(Severity severity, String message);
 
@@ -73,6 +118,9 @@ public class Logging {
 
 	public static native void logTimestamps(boolean enable);
 
+	private static native void addLogSinkConfig(Severity severity, LogSink sink,
+			LogSinkConfig config);
+
 	public static void verbose(String message) {
 		log(Severity.VERBOSE, message);
 	}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.condition.EnabledIfSystemProperty;
+
+/**
+ * Compares the single-thread factory mode and a sharded factory with the
+ * default network, signaling and worker thread layout. Measures the time to
+ * set up a data channel connection over loopback and the message rate of
+ * data channels running in parallel. Runs only with {@code
+ * -Dwebrtc.benchmark=true}, since timings are meaningless on shared build
+ * machines.
+ *
+ * @author Alex Andres
+ */
+@EnabledIfSystemProperty(named = "webrtc.benchmark", matches = "true")
+class FactoryThreadingBenchmark {
+
+	private static final int WARMUP_CONNECTIONS = 5;
+
+	private static final int CONNECTIONS = 20;
+
+	// Connections transferring at the same time.
+	private static final int PARALLEL_CONNECTIONS = 4;
+
+	private static final int MESSAGES = 20000;
+
+	private static final int MESSAGE_SIZE = 1024;
+
+
+	@Test
+	void connectionSetupAndThroughput() throws Exception {
+		PeerConnectionFactoryConfig singleThread = new PeerConnectionFactoryConfig();
+		singleThread.singleThread = true;
+
+		PeerConnectionFactoryConfig sharded = new PeerConnectionFactoryConfig();
+		sharded.shards = PARALLEL_CONNECTIONS;
+
+		Result threads = measure(new PeerConnectionFactoryConfig());
+		Result single = measure(singleThread);
+		Result shards = measure(sharded);
+
+		System.out.printf("Connection setup: three threads %8.2f ms, single thread %8.2f ms, %d shards %8.2f ms%n",
+				threads.setupMillis, single.setupMillis, PARALLEL_CONNECTIONS, shards.setupMillis);
+		System.out.printf("Message rate:     three threads %8.0f /s, single thread %8.0f /s, %d shards %8.0f /s%n",
+				threads.messageRate, single.messageRate, PARALLEL_CONNECTIONS, shards.messageRate);
+	}
+
+	private Result measure(PeerConnectionFactoryConfig config) throws Exception {
+		PeerConnectionFactory factory = new PeerConnectionFactory(config);
+
+		for (int i = 0; i < WARMUP_CONNECTIONS; i++) {
+			new TestDataChannelPair(factory).close();
+		}
+
+		long start = System.nanoTime();
+
+		for (int i = 0; i < CONNECTIONS; i++) {
+			new TestDataChannelPair(factory).close();
+		}
+
+		double setupMillis = (System.nanoTime() - start) / 1e6 / CONNECTIONS;
+
+		List<TestDataChannelPair> pairs = new ArrayList<>();
+
+		for (int i = 0; i < PARALLEL_CONNECTIONS; i++) {
+			pairs.add(new TestDataChannelPair(factory));
+		}
+
+		// Warm up the transports before measuring.
+		for (TestDataChannelPair pair : pairs) {
+			pair.transfer(MESSAGES / 10, MESSAGE_SIZE);
+		}
+
+		ExecutorService executor = Executors.newFixedThreadPool(PARALLEL_CONNECTIONS);
+		List<CompletableFuture<Long>> transfers = new ArrayList<>();
+
+		for (TestDataChannelPair pair : pairs) {
+			transfers.add(CompletableFuture.supplyAsync(() -> {
+				try {
+					return pair.transfer(MESSAGES, MESSAGE_SIZE);
+				}
+				catch (Exception e) {
+					throw new RuntimeException(e);
+				}
+			}, executor));
+		}
+
+		long slowest = 0;
+
+		for (CompletableFuture<Long> transfer : transfers) {
+			slowest = Math.max(slowest, transfer.get(60, TimeUnit.SECONDS));
+		}
+
+		executor.shutdown();
+
+		double messageRate = (double) MESSAGES * PARALLEL_CONNECTIONS / (slowest / 1e9);
+
+		for (TestDataChannelPair pair : pairs) {
+			pair.close();
+		}
+
+		assertArrayEquals(new int[config.shards], factory.getShardLoad());
+
+		factory.dispose();
+
+		return new Result(setupMillis, messageRate);
+	}
+
+	private record Result(double setupMillis, double messageRate) {
+
+	}
+
+}
@@ -18,6 +18,14 @@ package dev.kastle.webrtc;
 
 import static org.junit.jupiter.api.Assertions.*;
 
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+
 import org.junit.jupiter.api.Test;
 
 class PeerConnectionFactoryTests extends TestBase {
@@ -44,4 +52,401 @@ class PeerConnectionFactoryTests extends TestBase {
 
 		peerConnection.close();
 	}
+
+	@Test
+	void compileConfiguration() {
+		RTCConfiguration config = new RTCConfiguration();
+		config.iceTransportPolicy = RTCIceTransportPolicy.RELAY;
+		config.iceCandidatePoolSize = 1;
+
+		CompiledRTCConfiguration compiled = factory.compileConfiguration(config);
+
+		assertNotNull(compiled);
+
+		// Later changes to the source configuration are not compiled in.
+		config.iceTransportPolicy = RTCIceTransportPolicy.ALL;
+
+		RTCPeerConnection pc1 = factory.createPeerConnectionCompiled(compiled, candidate -> { });
+		RTCPeerConnection pc2 = factory.createPeerConnectionCompiled(compiled, candidate -> { });
+
+		assertEquals(RTCIceTransportPolicy.RELAY, pc1.getConfiguration().iceTransportPolicy);
+		assertEquals(RTCIceTransportPolicy.RELAY, pc2.getConfiguration().iceTransportPolicy);
+		assertEquals(1, pc2.getConfiguration().iceCandidatePoolSize);
+
+		compiled.release();
+
+		// Connections keep working after the compiled configuration is gone.
+		assertEquals(RTCIceTransportPolicy.RELAY, pc1.getConfiguration().iceTransportPolicy);
+
+		pc1.close();
+		pc2.close();
+
+		assertThrows(NullPointerException.class, () -> factory.createPeerConnectionCompiled(compiled, candidate -> { }));
+	}
+
+	@Test
+	void compileConfigurationNullParams() {
+		assertThrows(NullPointerException.class, () -> factory.compileConfiguration(null));
+
+		assertThrows(NullPointerException.class, () -> {
+			factory.createPeerConnectionCompiled(null, candidate -> {
+			});
+		});
+
+		CompiledRTCConfiguration compiled = factory.compileConfiguration(new RTCConfiguration());
+
+		assertThrows(NullPointerException.class, () -> factory.createPeerConnectionCompiled(compiled, null));
+
+		compiled.release();
+	}
+
+	@Test
+	void generateCertificate() {
+		RTCCertificate certificate = factory.generateCertificate(RTCKeyType.ECDSA);
+
+		assertNotNull(certificate);
+		assertTrue(certificate.getExpires() > System.currentTimeMillis());
+
+		RTCCertificatePEM pem = certificate.toPEM();
+
+		assertTrue(pem.getCertificate().contains("BEGIN CERTIFICATE"));
+		assertTrue(pem.getPrivateKey().contains("PRIVATE KEY"));
+		assertEquals(certificate.getExpires(), pem.getExpires());
+
+		// One certificate shared by several connections.
+		RTCConfiguration config = new RTCConfiguration();
+		config.nativeCertificates.add(certificate);
+
+		RTCPeerConnection pc1 = factory.createPeerConnection(config, candidate -> { });
+		RTCPeerConnection pc2 = factory.createPeerConnection(config, candidate -> { });
+
+		assertEquals(pem.getCertificate(), pc1.getConfiguration().certificates.get(0).getCertificate());
+		assertEquals(pem.getCertificate(), pc2.getConfiguration().certificates.get(0).getCertificate());
+
+		// Connections keep their own references.
+		certificate.release();
+
+		assertEquals(pem.getCertificate(), pc1.getConfiguration().certificates.get(0).getCertificate());
+
+		pc1.close();
+		pc2.close();
+
+		assertThrows(Error.class, () -> factory.createPeerConnection(config, candidate -> { }));
+	}
+
+	@Test
+	void generateCertificateAsync() throws Exception {
+		RTCCertificate certificate = factory.generateCertificateAsync(RTCKeyType.ECDSA)
+				.get(10, TimeUnit.SECONDS);
+
+		assertNotNull(certificate);
+		assertTrue(certificate.getExpires() > System.currentTimeMillis());
+
+		certificate.release();
+	}
+
+	@Test
+	void generateCertificateAsyncDispose() throws Exception {
+		PeerConnectionFactory disposedFactory = new PeerConnectionFactory();
+		List<CompletableFuture<RTCCertificate>> futures = new ArrayList<>();
+
+		for (int i = 0; i < 8; i++) {
+			futures.add(disposedFactory.generateCertificateAsync(RTCKeyType.RSA));
+		}
+
+		disposedFactory.dispose();
+
+		// Each generation either finished before or was failed by dispose.
+		for (CompletableFuture<RTCCertificate> future : futures) {
+			assertTrue(future.isDone());
+
+			if (!future.isCompletedExceptionally()) {
+				future.get().release();
+			}
+		}
+	}
+
+	@Test
+	void generateCertificateNullParams() {
+		assertThrows(NullPointerException.class, () -> factory.generateCertificate(null));
+	}
+
+	@Test
+	void shardLoad() {
+		assertArrayEquals(new int[] { 0 }, factory.getShardLoad());
+
+		RTCPeerConnection peerConnection = factory.createPeerConnection(
+				new RTCConfiguration(), candidate -> { });
+
+		assertArrayEquals(new int[] { 1 }, factory.getShardLoad());
+
+		peerConnection.close();
+
+		assertArrayEquals(new int[] { 0 }, factory.getShardLoad());
+	}
+
+	@Test
+	void shardedRoundRobin() {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.shards = 2;
+		factoryConfig.placement = PeerConnectionPlacement.ROUND_ROBIN;
+
+		PeerConnectionFactory shardedFactory = new PeerConnectionFactory(factoryConfig);
+		RTCPeerConnection[] peerConnections = new RTCPeerConnection[4];
+
+		for (int i = 0; i < peerConnections.length; i++) {
+			peerConnections[i] = shardedFactory.createPeerConnection(
+					new RTCConfiguration(), candidate -> { });
+		}
+
+		assertArrayEquals(new int[] { 2, 2 }, shardedFactory.getShardLoad());
+
+		for (RTCPeerConnection peerConnection : peerConnections) {
+			peerConnection.close();
+		}
+
+		assertArrayEquals(new int[] { 0, 0 }, shardedFactory.getShardLoad());
+
+		shardedFactory.dispose();
+	}
+
+	@Test
+	void shardedLeastLoaded() {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.shards = 2;
+		factoryConfig.placement = PeerConnectionPlacement.LEAST_LOADED;
+
+		PeerConnectionFactory shardedFactory = new PeerConnectionFactory(factoryConfig);
+
+		RTCPeerConnection first = shardedFactory.createPeerConnection(
+				new RTCConfiguration(), candidate -> { });
+		RTCPeerConnection second = shardedFactory.createPeerConnection(
+				new RTCConfiguration(), candidate -> { });
+
+		assertArrayEquals(new int[] { 1, 1 }, shardedFactory.getShardLoad());
+
+		first.close();
+
+		RTCPeerConnection third = shardedFactory.createPeerConnection(
+				new RTCConfiguration(), candidate -> { });
+
+		assertArrayEquals(new int[] { 1, 1 }, shardedFactory.getShardLoad());
+
+		second.close();
+		third.close();
+
+		shardedFactory.dispose();
+	}
+
+	@Test
+	void closeAsync() throws Exception {
+		RTCPeerConnection peerConnection = factory.createPeerConnection(
+				new RTCConfiguration(), candidate -> { });
+
+		CompletableFuture<Void> closed = peerConnection.closeAsync();
+
+		// Closed for the caller right away.
+		assertThrows(NullPointerException.class, peerConnection::close);
+
+		closed.get(10, TimeUnit.SECONDS);
+
+		assertArrayEquals(new int[] { 0 }, factory.getShardLoad());
+	}
+
+	@Test
+	void disposeWithPendingClose() throws Exception {
+		PeerConnectionFactory closingFactory = new PeerConnectionFactory();
+		List<RTCPeerConnection> peerConnections = new ArrayList<>();
+
+		for (int i = 0; i < 10; i++) {
+			peerConnections.add(closingFactory.createPeerConnection(
+					new RTCConfiguration(), candidate -> { }));
+		}
+
+		CompletableFuture<Void> closed = closingFactory.closeAll(peerConnections);
+
+		// Queued close batches run before the factory is released.
+		closingFactory.dispose();
+
+		assertTrue(closed.isDone());
+	}
+
+	@Test
+	void closeAll() throws Exception {
+		assertThrows(NullPointerException.class, () -> factory.closeAll(null));
+
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.shards = 2;
+
+		PeerConnectionFactory shardedFactory = new PeerConnectionFactory(factoryConfig);
+		List<RTCPeerConnection> peerConnections = new ArrayList<>();
+
+		for (int i = 0; i < 200; i++) {
+			peerConnections.add(shardedFactory.createPeerConnection(
+					new RTCConfiguration(), candidate -> { }));
+		}
+
+		assertArrayEquals(new int[] { 100, 100 }, shardedFactory.getShardLoad());
+
+		// Closed connections and null entries are skipped.
+		peerConnections.get(0).close();
+		peerConnections.add(null);
+
+		shardedFactory.closeAll(peerConnections).get(10, TimeUnit.SECONDS);
+
+		assertArrayEquals(new int[] { 0, 0 }, shardedFactory.getShardLoad());
+
+		for (RTCPeerConnection peerConnection : peerConnections) {
+			if (peerConnection != null) {
+				assertThrows(NullPointerException.class, peerConnection::close);
+			}
+		}
+
+		// Nothing left to close.
+		shardedFactory.closeAll(peerConnections).get(10, TimeUnit.SECONDS);
+		shardedFactory.closeAll(new ArrayList<>()).get(10, TimeUnit.SECONDS);
+
+		shardedFactory.dispose();
+	}
+
+	@Test
+	void singleThread() throws Exception {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.singleThread = true;
+
+		PeerConnectionFactory singleThreadFactory = new PeerConnectionFactory(factoryConfig);
+
+		TestPeerConnection caller = new TestPeerConnection(singleThreadFactory);
+		TestPeerConnection callee = new TestPeerConnection(singleThreadFactory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		assertEquals(RTCPeerConnectionState.CONNECTED, caller.getPeerConnection().getConnectionState());
+		assertEquals(RTCPeerConnectionState.CONNECTED, callee.getPeerConnection().getConnectionState());
+
+		caller.close();
+		callee.close();
+
+		singleThreadFactory.dispose();
+	}
+
+	@Test
+	void disposeWithOpenConnection() {
+		PeerConnectionFactory openFactory = new PeerConnectionFactory();
+
+		RTCPeerConnection peerConnection = openFactory.createPeerConnection(new RTCConfiguration(), candidate -> { });
+
+		assertThrows(IllegalStateException.class, openFactory::dispose);
+
+		peerConnection.close();
+
+		openFactory.dispose();
+	}
+
+	@Test
+	void sharedNetworkManager() throws Exception {
+		List<Set<String>> networks = new ArrayList<>();
+
+		// Consecutive connections reuse the networks enumerated by the shard.
+		for (int i = 0; i < 2; i++) {
+			Set<String> hostNetworks = ConcurrentHashMap.newKeySet();
+
+			TestPeerConnection caller = new TestPeerConnection(factory) {
+
+				@Override
+				public void onIceCandidate(RTCIceCandidate candidate) {
+					// "candidate:... <address> <port> typ host ... network-id <id> ..."
+					List<String> parts = List.of(candidate.sdp.trim().split("\\s+"));
+					int networkId = parts.indexOf("network-id");
+
+					if (parts.contains("host") && networkId > 0) {
+						hostNetworks.add(parts.get(4) + " " + parts.get(networkId + 1));
+					}
+
+					super.onIceCandidate(candidate);
+				}
+			};
+			TestPeerConnection callee = new TestPeerConnection(factory);
+
+			caller.setRemotePeerConnection(callee);
+			callee.setRemotePeerConnection(caller);
+
+			callee.setRemoteDescription(caller.createOffer());
+			caller.setRemoteDescription(callee.createAnswer());
+
+			caller.waitUntilConnected();
+			callee.waitUntilConnected();
+
+			long deadline = System.currentTimeMillis() + 10000;
+
+			while (caller.getPeerConnection().getIceGatheringState() != RTCIceGatheringState.COMPLETE) {
+				assertTrue(System.currentTimeMillis() < deadline, "Gathering not completed in time");
+
+				Thread.sleep(20);
+			}
+
+			networks.add(hostNetworks);
+
+			caller.close();
+			callee.close();
+		}
+
+		// The same network objects, with the ids the shard assigned once.
+		assertFalse(networks.get(0).isEmpty());
+		assertEquals(networks.get(0), networks.get(1));
+	}
+
+	@Test
+	void applicationSignalingThread() throws Exception {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.applicationSignalingThread = true;
+
+		PeerConnectionFactory appThreadFactory = new PeerConnectionFactory(factoryConfig);
+
+		RTCPeerConnection peerConnection = appThreadFactory.createPeerConnection(
+				new RTCConfiguration(), candidate -> { });
+		peerConnection.createDataChannel("dc", new RTCDataChannelInit());
+
+		TestCreateDescObserver observer = new TestCreateDescObserver();
+
+		peerConnection.createOffer(new RTCOfferOptions(), observer);
+
+		// The callback is only delivered by pumping the signaling thread.
+		for (int i = 0; i < 500 && !observer.isDone(); i++) {
+			appThreadFactory.processMessages(10);
+		}
+
+		assertTrue(observer.isDone());
+		assertNotNull(observer.get());
+
+		peerConnection.close();
+
+		CompletableFuture<Void> foreignDispose = CompletableFuture.runAsync(appThreadFactory::dispose);
+
+		ExecutionException e = assertThrows(ExecutionException.class,
+				() -> foreignDispose.get(10, TimeUnit.SECONDS));
+		assertInstanceOf(IllegalStateException.class, e.getCause());
+
+		appThreadFactory.dispose();
+	}
+
+	@Test
+	void processMessagesWithoutApplicationThread() {
+		assertThrows(Error.class, () -> factory.processMessages(0));
+	}
+
+	@Test
+	void invalidShards() {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.shards = 0;
+
+		assertThrows(Error.class, () -> new PeerConnectionFactory(factoryConfig));
+	}
 }
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import org.junit.jupiter.api.Test;
+
+class PeerConnectionPoolTests extends TestBase {
+
+	@Test
+	void acquireAndRefill() throws Exception {
+		RTCConfiguration config = new RTCConfiguration();
+		config.iceCandidatePoolSize = 1;
+
+		PeerConnectionPool pool = new PeerConnectionPool(factory, config, 2);
+
+		assertTrue(awaitAvailable(pool, 2));
+
+		CountDownLatch candidateLatch = new CountDownLatch(1);
+
+		RTCPeerConnection peerConnection = pool.acquire(candidate -> candidateLatch.countDown());
+		peerConnection.createDataChannel("dc", new RTCDataChannelInit());
+
+		TestCreateDescObserver createObserver = new TestCreateDescObserver();
+		TestSetDescObserver setObserver = new TestSetDescObserver();
+
+		peerConnection.createOffer(new RTCOfferOptions(), createObserver);
+		peerConnection.setLocalDescription(createObserver.get(), setObserver);
+		setObserver.get();
+
+		// Events of the acquired connection reach the assigned observer.
+		assertTrue(candidateLatch.await(10, TimeUnit.SECONDS));
+
+		assertTrue(awaitAvailable(pool, 2));
+
+		peerConnection.close();
+		pool.close();
+
+		assertEquals(0, pool.available());
+		assertThrows(IllegalStateException.class, () -> pool.acquire(candidate -> { }));
+	}
+
+	@Test
+	void invalidParams() {
+		assertThrows(NullPointerException.class, () -> new PeerConnectionPool(null, new RTCConfiguration(), 1));
+		assertThrows(NullPointerException.class, () -> new PeerConnectionPool(factory, null, 1));
+		assertThrows(IllegalArgumentException.class, () -> new PeerConnectionPool(factory, new RTCConfiguration(), 0));
+	}
+
+	private static boolean awaitAvailable(PeerConnectionPool pool, int count) throws InterruptedException {
+		long deadline = System.currentTimeMillis() + 10000;
+
+		while (pool.available() < count) {
+			if (System.currentTimeMillis() > deadline) {
+				return false;
+			}
+
+			Thread.sleep(10);
+		}
+
+		return true;
+	}
+}
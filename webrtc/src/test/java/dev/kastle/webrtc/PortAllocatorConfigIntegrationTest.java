@@ -18,6 +18,8 @@ package dev.kastle.webrtc;
 
 import static org.junit.jupiter.api.Assertions.*;
 
+import java.net.DatagramSocket;
+import java.net.SocketException;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.concurrent.CountDownLatch;
@@ -95,6 +97,119 @@ class PortAllocatorConfigIntegrationTest extends TestBase {
 		callee.close();
 	}
 
+	@Test
+	void sharedUdpPort() throws Exception {
+		int sharedPort = findFreeUdpPort();
+
+		RTCConfiguration serverCfg = new RTCConfiguration();
+		serverCfg.portAllocatorConfig.sharedUdpPort = sharedPort;
+		serverCfg.portAllocatorConfig.setDisableTcp(true);
+
+		RTCConfiguration clientCfg = new RTCConfiguration();
+		clientCfg.portAllocatorConfig.setDisableTcp(true);
+
+		AllocPeer server1 = new AllocPeer(factory, serverCfg);
+		AllocPeer server2 = new AllocPeer(factory, serverCfg);
+		AllocPeer client1 = new AllocPeer(factory, clientCfg);
+		AllocPeer client2 = new AllocPeer(factory, clientCfg);
+
+		server1.setRemotePeer(client1);
+		client1.setRemotePeer(server1);
+		server2.setRemotePeer(client2);
+		client2.setRemotePeer(server2);
+
+		server1.setRemoteDescription(client1.createOffer());
+		client1.setRemoteDescription(server1.createAnswer());
+		server2.setRemoteDescription(client2.createOffer());
+		client2.setRemoteDescription(server2.createAnswer());
+
+		assertTrue(server1.awaitConnected(30, TimeUnit.SECONDS), "First server connection timed out");
+		assertTrue(server2.awaitConnected(30, TimeUnit.SECONDS), "Second server connection timed out");
+		assertTrue(client1.awaitConnected(30, TimeUnit.SECONDS), "First client connection timed out");
+		assertTrue(client2.awaitConnected(30, TimeUnit.SECONDS), "Second client connection timed out");
+
+		// Both server connections gathered their UDP host candidates on the shared port.
+		for (AllocPeer server : List.of(server1, server2)) {
+			for (String c : server.candidates) {
+				if (c.contains(" udp ") && c.contains(" typ host")) {
+					assertEquals(sharedPort, parsePortFromCandidate(c), c);
+				}
+			}
+		}
+
+		server1.close();
+		server2.close();
+		client1.close();
+		client2.close();
+	}
+
+	@Test
+	void sharedUdpPortRequiresSingleShard() throws Exception {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.shards = 2;
+
+		PeerConnectionFactory shardedFactory = new PeerConnectionFactory(factoryConfig);
+
+		RTCConfiguration cfg = new RTCConfiguration();
+		cfg.portAllocatorConfig.sharedUdpPort = findFreeUdpPort();
+
+		assertThrows(IllegalArgumentException.class, () -> shardedFactory.createPeerConnection(cfg, candidate -> { }));
+		assertArrayEquals(new int[] { 0, 0 }, shardedFactory.getShardLoad());
+
+		shardedFactory.dispose();
+	}
+
+	@Test
+	void sharedUdpPortInUse() throws Exception {
+		try (DatagramSocket socket = new DatagramSocket(0)) {
+			RTCConfiguration cfg = new RTCConfiguration();
+			cfg.portAllocatorConfig.sharedUdpPort = socket.getLocalPort();
+
+			assertThrows(Error.class, () -> factory.createPeerConnection(cfg, candidate -> { }));
+		}
+	}
+
+	@Test
+	void interfaceAllowList() throws Exception {
+		// Documentation-only network, no local interface is allowed.
+		RTCConfiguration cfg = new RTCConfiguration();
+		cfg.portAllocatorConfig.interfaceAllowList.add("192.0.2.0/24");
+		cfg.portAllocatorConfig.disableIpv6 = true;
+
+		AllocPeer peer = new AllocPeer(factory, cfg);
+		peer.createOffer();
+
+		assertTrue(peer.awaitGatheringComplete(30, TimeUnit.SECONDS), "Gathering timed out");
+
+		for (String c : peer.candidates) {
+			assertFalse(c.contains(" typ host"), "Host candidate on filtered interface: " + c);
+		}
+
+		peer.close();
+	}
+
+	@Test
+	void invalidInterfaceEntry() {
+		RTCConfiguration cfg = new RTCConfiguration();
+		cfg.portAllocatorConfig.interfaceDenyList.add("10.0.0.0/99");
+
+		assertThrows(IllegalArgumentException.class, () -> new AllocPeer(factory, cfg));
+
+		cfg.portAllocatorConfig.interfaceDenyList.set(0, "");
+
+		assertThrows(IllegalArgumentException.class, () -> factory.compileConfiguration(cfg));
+
+		cfg.portAllocatorConfig.interfaceDenyList.set(0, "10.0.0/8");
+
+		assertThrows(IllegalArgumentException.class, () -> new AllocPeer(factory, cfg));
+	}
+
+	private static int findFreeUdpPort() throws SocketException {
+		try (DatagramSocket socket = new DatagramSocket(0)) {
+			return socket.getLocalPort();
+		}
+	}
+
 	private static int parsePortFromCandidate(String sdp) {
 		// Typical candidate line:
 		// candidate:<foundation> <component> <protocol> <priority> <ip> <port> typ <type> ...
@@ -116,6 +231,7 @@ class PortAllocatorConfigIntegrationTest extends TestBase {
 		private final RTCPeerConnection pc;
 		private RTCPeerConnection remote;
 		private final CountDownLatch gatheringComplete = new CountDownLatch(1);
+		private final CountDownLatch connected = new CountDownLatch(1);
 		final List<String> candidates = new ArrayList<>();
 
 
@@ -159,6 +275,10 @@ class PortAllocatorConfigIntegrationTest extends TestBase {
 			return gatheringComplete.await(timeout, unit);
 		}
 
+		boolean awaitConnected(long timeout, TimeUnit unit) throws InterruptedException {
+			return connected.await(timeout, unit);
+		}
+
 		void close() {
 			pc.close();
 		}
@@ -177,5 +297,12 @@ class PortAllocatorConfigIntegrationTest extends TestBase {
 				gatheringComplete.countDown();
 			}
 		}
+
+		@Override
+		public void onIceConnectionChange(RTCIceConnectionState state) {
+			if (state == RTCIceConnectionState.CONNECTED || state == RTCIceConnectionState.COMPLETED) {
+				connected.countDown();
+			}
+		}
 	}
 }
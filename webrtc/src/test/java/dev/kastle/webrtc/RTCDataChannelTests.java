@@ -18,6 +18,8 @@ package dev.kastle.webrtc;
 
 import static java.util.Objects.nonNull;
 import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertInstanceOf;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
 import java.nio.ByteBuffer;
@@ -25,7 +27,10 @@ import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.List;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
 
 import org.junit.jupiter.api.Assertions;
 import org.junit.jupiter.api.Test;
@@ -105,6 +110,239 @@ class RTCDataChannelTests extends TestBase {
 		callee.close();
 	}
 
+	@Test
+	void batchingSocketServer() throws Exception {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.socketServer = SocketServerType.BATCHING;
+
+		PeerConnectionFactory batchingFactory = new PeerConnectionFactory(factoryConfig);
+
+		DataPeerConnection caller = new DataPeerConnection(batchingFactory);
+		DataPeerConnection callee = new DataPeerConnection(batchingFactory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		Thread.sleep(500);
+
+		List<String> expected = new ArrayList<>();
+
+		for (int i = 0; i < 100; i++) {
+			String message = "Message " + i;
+
+			expected.add(message);
+			caller.sendTextMessage(message);
+		}
+
+		Thread.sleep(1000);
+
+		assertEquals(expected, callee.getReceivedTexts());
+
+		caller.close();
+		callee.close();
+
+		batchingFactory.dispose();
+	}
+
+	@Test
+	void udpOffload() throws Exception {
+		PeerConnectionFactoryConfig factoryConfig = new PeerConnectionFactoryConfig();
+		factoryConfig.udpOffload = true;
+
+		PeerConnectionFactory offloadFactory = new PeerConnectionFactory(factoryConfig);
+
+		DataPeerConnection caller = new DataPeerConnection(offloadFactory);
+		DataPeerConnection callee = new DataPeerConnection(offloadFactory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		Thread.sleep(500);
+
+		// MTU-sized messages, which are sent as equally sized datagrams.
+		String message = "x".repeat(1100);
+		int count = 200;
+
+		for (int i = 0; i < count; i++) {
+			caller.sendTextMessage(message);
+		}
+
+		Thread.sleep(1000);
+
+		assertEquals(Collections.nCopies(count, message), callee.getReceivedTexts());
+
+		// Without kernel support the datagrams are sent one by one.
+		if (PeerConnectionFactory.isUdpOffloadSupported()) {
+			assertTrue(offloadFactory.getOffloadedDatagrams() > 0, "Datagrams should be sent with GSO");
+		}
+
+		caller.close();
+		callee.close();
+
+		offloadFactory.dispose();
+	}
+
+	@Test
+	void counters() throws Exception {
+		DataPeerConnection caller = new DataPeerConnection(factory);
+		DataPeerConnection callee = new DataPeerConnection(factory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		Thread.sleep(500);
+
+		caller.sendTextMessage("Hello");
+		caller.sendTextMessage("world");
+
+		Thread.sleep(500);
+
+		long[] sent = new long[RTCDataChannel.COUNTER_COUNT];
+		long[] received = new long[RTCDataChannel.COUNTER_COUNT];
+
+		caller.getLocalDataChannel().getCounters(sent);
+		callee.getRemoteDataChannel().getCounters(received);
+
+		assertEquals(2, sent[RTCDataChannel.COUNTER_MESSAGES_SENT]);
+		assertEquals(10, sent[RTCDataChannel.COUNTER_BYTES_SENT]);
+		assertEquals(0, sent[RTCDataChannel.COUNTER_MESSAGES_RECEIVED]);
+		assertEquals(2, received[RTCDataChannel.COUNTER_MESSAGES_RECEIVED]);
+		assertEquals(10, received[RTCDataChannel.COUNTER_BYTES_RECEIVED]);
+
+		caller.close();
+		callee.close();
+	}
+
+	@Test
+	void closeWhenDrained() throws Exception {
+		DataPeerConnection caller = new DataPeerConnection(factory);
+		DataPeerConnection callee = new DataPeerConnection(factory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		Thread.sleep(500);
+
+		RTCDataChannel channel = caller.getLocalDataChannel();
+
+		for (int i = 0; i < 16; i++) {
+			channel.send(new RTCDataChannelBuffer(ByteBuffer.wrap(new byte[64 * 1024]), true));
+		}
+
+		boolean drained = channel.closeWhenDrained(5000).get(10, TimeUnit.SECONDS);
+
+		assertTrue(drained, "Buffered data should be sent before closing");
+		assertEquals(0, channel.getBufferedAmount());
+
+		Thread.sleep(500);
+
+		long[] received = new long[RTCDataChannel.COUNTER_COUNT];
+
+		callee.getRemoteDataChannel().getCounters(received);
+
+		assertEquals(16, received[RTCDataChannel.COUNTER_MESSAGES_RECEIVED]);
+
+		Assertions.assertThrows(IllegalArgumentException.class, () -> {
+			channel.closeWhenDrained(-1);
+		});
+
+		caller.close();
+		callee.close();
+	}
+
+	@Test
+	void closeWhenDrainedObserverAndDispose() throws Exception {
+		DataPeerConnection caller = new DataPeerConnection(factory);
+		DataPeerConnection callee = new DataPeerConnection(factory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		RTCDataChannel channel = openFilledChannel(caller, "drain", 16);
+
+		CompletableFuture<Boolean> drained = channel.closeWhenDrained(60000);
+
+		// The drain must keep receiving events from a replaced observer.
+		channel.registerObserver(new RTCDataChannelObserver() {
+
+			@Override
+			public void onBufferedAmountChange(long previousAmount) { }
+
+			@Override
+			public void onStateChange() { }
+
+			@Override
+			public void onMessage(RTCDataChannelBuffer buffer) { }
+		});
+
+		assertTrue(drained.get(10, TimeUnit.SECONDS));
+
+		channel.unregisterObserver();
+		channel.dispose();
+
+		// A pending drain must not keep the channel alive. Enough data is
+		// queued that the channel cannot drain before it is disposed.
+		RTCDataChannel disposed = openFilledChannel(caller, "dispose", 200);
+
+		CompletableFuture<Boolean> pending = disposed.closeWhenDrained(60000);
+
+		disposed.dispose();
+
+		ExecutionException e = assertThrows(ExecutionException.class, () -> pending.get(10, TimeUnit.SECONDS));
+
+		assertInstanceOf(RuntimeException.class, e.getCause());
+		assertTrue(e.getCause().getMessage().contains("Data channel disposed before drained"), e.getCause().getMessage());
+
+		caller.close();
+		callee.close();
+	}
+
+	private static RTCDataChannel openFilledChannel(DataPeerConnection peerConnection, String label, int messages) throws Exception {
+		RTCDataChannel channel = peerConnection.getPeerConnection().createDataChannel(label, new RTCDataChannelInit());
+
+		for (int i = 0; i < 50 && channel.getState() != RTCDataChannelState.OPEN; i++) {
+			Thread.sleep(100);
+		}
+
+		assertEquals(RTCDataChannelState.OPEN, channel.getState());
+
+		for (int i = 0; i < messages; i++) {
+			channel.send(new RTCDataChannelBuffer(ByteBuffer.wrap(new byte[64 * 1024]), true));
+		}
+
+		return channel;
+	}
+
 
 
 	private static class DataPeerConnection extends TestPeerConnection {
@@ -149,6 +387,10 @@ class RTCDataChannelTests extends TestBase {
 			return localDataChannel;
 		}
 
+		RTCDataChannel getRemoteDataChannel() {
+			return remoteDataChannel;
+		}
+
 		List<String> getReceivedTexts() {
 			return receivedTexts;
 		}
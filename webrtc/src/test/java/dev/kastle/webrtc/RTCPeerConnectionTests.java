@@ -18,8 +18,21 @@ package dev.kastle.webrtc;
 
 import static org.junit.jupiter.api.Assertions.*;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicReference;
+import java.util.function.BooleanSupplier;
 
 import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
@@ -83,6 +96,81 @@ class RTCPeerConnectionTests extends TestBase {
 		peerConnection.close();
 	}
 
+	@Test
+	void configurationSnapshot() {
+		RTCConfiguration config = new RTCConfiguration();
+		config.iceTransportPolicy = RTCIceTransportPolicy.RELAY;
+
+		config.iceServers.add(new RTCIceServer());
+		config.iceServers.get(0).urls.add("stun:stun.example.org");
+
+		RTCPeerConnection peerConnection = factory.createPeerConnection(config, candidate -> {});
+		RTCConfiguration peerConfig = peerConnection.getConfiguration();
+
+		// Each call returns an independent copy.
+		RTCConfiguration other = peerConnection.getConfiguration();
+
+		assertNotSame(peerConfig, other);
+		assertNotSame(peerConfig.iceServers, other.iceServers);
+		assertNotSame(peerConfig.iceServers.get(0), other.iceServers.get(0));
+		assertNotSame(peerConfig.portAllocatorConfig, other.portAllocatorConfig);
+
+		// Modifying a copy does not affect the connection.
+		peerConfig.iceTransportPolicy = RTCIceTransportPolicy.ALL;
+		peerConfig.iceServers.get(0).urls.clear();
+
+		RTCConfiguration unchanged = peerConnection.getConfiguration();
+
+		assertEquals(RTCIceTransportPolicy.RELAY, unchanged.iceTransportPolicy);
+		assertEquals(List.of("stun:stun.example.org"), unchanged.iceServers.get(0).urls);
+
+		// Applying the modified copy updates the snapshot.
+		peerConfig.iceServers.get(0).urls.add("stun:stun.example.org");
+
+		peerConnection.setConfiguration(peerConfig);
+
+		RTCConfiguration updated = peerConnection.getConfiguration();
+
+		assertEquals(RTCIceTransportPolicy.ALL, updated.iceTransportPolicy);
+
+		peerConnection.close();
+
+		// The snapshot does not survive closing the connection.
+		assertThrows(NullPointerException.class, peerConnection::getConfiguration);
+	}
+
+	@Test
+	void configurationCreationOptions() {
+		RTCConfiguration config = new RTCConfiguration();
+		config.iceLite = true;
+		config.iceCandidateBatchWindow = 50;
+		config.portAllocatorConfig.interfaceDenyList.add("docker*");
+		config.portAllocatorConfig.disableIpv6 = true;
+
+		RTCPeerConnection peerConnection = factory.createPeerConnection(config, candidate -> {});
+		RTCConfiguration peerConfig = peerConnection.getConfiguration();
+
+		assertTrue(peerConfig.iceLite);
+		assertEquals(50, peerConfig.iceCandidateBatchWindow);
+		assertEquals(List.of("docker*"), peerConfig.portAllocatorConfig.interfaceDenyList);
+		assertTrue(peerConfig.portAllocatorConfig.disableIpv6);
+
+		// The queried configuration can be applied as is.
+		peerConnection.setConfiguration(peerConfig);
+
+		RTCConfiguration changed = peerConnection.getConfiguration();
+		changed.iceLite = false;
+
+		assertThrows(RuntimeException.class, () -> peerConnection.setConfiguration(changed));
+
+		RTCConfiguration filterChanged = peerConnection.getConfiguration();
+		filterChanged.portAllocatorConfig.interfaceDenyList.clear();
+
+		assertThrows(RuntimeException.class, () -> peerConnection.setConfiguration(filterChanged));
+
+		peerConnection.close();
+	}
+
 	@Test
 	void createDataChannel() {
 		RTCDataChannelInit options = new RTCDataChannelInit();
@@ -108,6 +196,72 @@ class RTCPeerConnectionTests extends TestBase {
 		assertEquals(options.protocol, channel.getProtocol());
 	}
 
+	@Test
+	void createDataChannels() {
+		RTCDataChannelInit control = new RTCDataChannelInit();
+		control.protocol = "control";
+
+		RTCDataChannelInit state = new RTCDataChannelInit();
+		state.protocol = "state";
+		state.ordered = false;
+		state.maxRetransmits = 0;
+
+		assertThrows(NullPointerException.class, () -> peerConnection.createDataChannels(null, new RTCDataChannelInit[] { control }));
+		assertThrows(NullPointerException.class, () -> peerConnection.createDataChannels(new String[1], (RTCDataChannelInit[]) null));
+		assertThrows(NullPointerException.class, () -> peerConnection.createDataChannels(new String[] { "dc" }, new RTCDataChannelInit[1]));
+		assertThrows(NullPointerException.class, () -> peerConnection.createDataChannels(new String[1], new RTCDataChannelInit[] { control }));
+		assertThrows(IllegalArgumentException.class, () -> peerConnection.createDataChannels(new String[3], new RTCDataChannelInit[2]));
+		assertThrows(NullPointerException.class, () -> factory.compileDataChannelInit(null));
+
+		RTCDataChannel[] channels = peerConnection.createDataChannels(
+				new String[] { "control", "state" },
+				new RTCDataChannelInit[] { control, state });
+
+		assertEquals(2, channels.length);
+		assertEquals("control", channels[0].getLabel());
+		assertEquals("control", channels[0].getProtocol());
+		assertTrue(channels[0].isOrdered());
+		assertEquals("state", channels[1].getLabel());
+		assertEquals("state", channels[1].getProtocol());
+		assertFalse(channels[1].isOrdered());
+		assertEquals(0, channels[1].getMaxRetransmits());
+
+		// One compiled dictionary for many channels.
+		CompiledRTCDataChannelInit compiled = factory.compileDataChannelInit(state);
+
+		// Later changes to the source dictionary are not compiled in.
+		state.protocol = "changed";
+
+		String[] labels = new String[100];
+
+		for (int i = 0; i < labels.length; i++) {
+			labels[i] = "bulk-" + i;
+		}
+
+		RTCDataChannel[] bulk = peerConnection.createDataChannels(labels,
+				new CompiledRTCDataChannelInit[] { compiled });
+
+		assertEquals(labels.length, bulk.length);
+
+		for (int i = 0; i < bulk.length; i++) {
+			assertEquals(labels[i], bulk[i].getLabel());
+			assertEquals("state", bulk[i].getProtocol());
+			assertFalse(bulk[i].isOrdered());
+		}
+
+		compiled.release();
+
+		assertThrows(NullPointerException.class, () -> peerConnection.createDataChannels(labels,
+				new CompiledRTCDataChannelInit[] { compiled }));
+
+		for (RTCDataChannel channel : channels) {
+			channel.dispose();
+		}
+		for (RTCDataChannel channel : bulk) {
+			channel.dispose();
+		}
+	}
+
 	@Test
 	void createOfferNullParams() {
 		assertThrows(NullPointerException.class, () -> {
@@ -191,6 +345,356 @@ class RTCPeerConnectionTests extends TestBase {
 		Thread.sleep(1000);
 	}
 
+	@Test
+	void dataSessionTemplate() throws Exception {
+		RTCConfiguration config = new RTCConfiguration();
+		config.sdpTemplate = true;
+
+		TestPeerConnection caller = new TestPeerConnection(factory, config);
+		TestPeerConnection callee = new TestPeerConnection(factory, config);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		RTCSessionDescription offer = caller.createOffer();
+
+		// Data channel only sessions are written from the template.
+		assertTrue(offer.sdp.startsWith("v=0\r\no=- "));
+		assertTrue(offer.sdp.contains("m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"));
+
+		// Unknown attributes are handled by the generic parser.
+		callee.setRemoteDescription(new RTCSessionDescription(RTCSdpType.OFFER, offer.sdp + "a=x-unknown:1\r\n"));
+
+		RTCSessionDescription answer = callee.createAnswer();
+
+		assertTrue(answer.sdp.contains("a=setup:active\r\n"));
+
+		caller.setRemoteDescription(answer);
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		caller.close();
+		callee.close();
+	}
+
+	@Test
+	void dataSessionTemplateMatchesGenericSerializer() throws Exception {
+		RTCConfiguration config = new RTCConfiguration();
+		config.sdpTemplate = true;
+
+		RTCPeerConnection local = factory.createPeerConnection(config, candidate -> {});
+		RTCPeerConnection generic = factory.createPeerConnection(new RTCConfiguration(), candidate -> {});
+
+		local.createDataChannel("dc", new RTCDataChannelInit());
+
+		RTCSessionDescription offer = local.createOfferAsync(new RTCOfferOptions()).get(10, TimeUnit.SECONDS);
+		local.setLocalDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+
+		awaitCondition(() -> local.getIceGatheringState() == RTCIceGatheringState.COMPLETE);
+
+		// Includes the gathered candidates and the default destination.
+		RTCSessionDescription gathered = local.getLocalDescription();
+
+		assertTrue(gathered.sdp.contains("a=candidate:"));
+
+		generic.setRemoteDescriptionAsync(gathered).get(10, TimeUnit.SECONDS);
+
+		// Written again by the generic serializer.
+		assertEquals(gathered.sdp, generic.getRemoteDescription().sdp);
+
+		local.close();
+		generic.close();
+	}
+
+	@Test
+	void negotiationNullParams() {
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.createAndSetLocalOffer(null, new TestNegotiationCallback());
+		});
+
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.createAndSetLocalOffer(new RTCOfferOptions(), null);
+		});
+
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.answerRemoteOffer(null, new RTCAnswerOptions(), new TestNegotiationCallback());
+		});
+
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.answerRemoteOffer("", null, new TestNegotiationCallback());
+		});
+
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.answerRemoteOffer("", new RTCAnswerOptions(), null);
+		});
+
+		assertThrows(Error.class, () -> {
+			peerConnection.answerRemoteOffer("invalid", new RTCAnswerOptions(), new TestNegotiationCallback());
+		});
+	}
+
+	@Test
+	void negotiationPipeline() throws Exception {
+		TestPeerConnection caller = new TestPeerConnection(factory);
+		TestPeerConnection callee = new TestPeerConnection(factory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		RTCPeerConnection callerConnection = caller.getPeerConnection();
+		RTCPeerConnection calleeConnection = callee.getPeerConnection();
+
+		TestNegotiationCallback offerCallback = new TestNegotiationCallback();
+		callerConnection.createAndSetLocalOffer(new RTCOfferOptions(), offerCallback);
+
+		String offer = offerCallback.get(10, TimeUnit.SECONDS);
+
+		assertFalse(offer.isEmpty());
+		assertEquals(RTCSignalingState.HAVE_LOCAL_OFFER, callerConnection.getSignalingState());
+
+		TestNegotiationCallback answerCallback = new TestNegotiationCallback();
+		calleeConnection.answerRemoteOffer(offer, new RTCAnswerOptions(), answerCallback);
+
+		String answer = answerCallback.get(10, TimeUnit.SECONDS);
+
+		assertFalse(answer.isEmpty());
+		assertEquals(RTCSignalingState.STABLE, calleeConnection.getSignalingState());
+		assertEquals(answer, calleeConnection.getCurrentLocalDescription().sdp);
+
+		caller.setRemoteDescription(new RTCSessionDescription(RTCSdpType.ANSWER, answer));
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		assertEquals(RTCPeerConnectionState.CONNECTED, callerConnection.getConnectionState());
+		assertEquals(RTCPeerConnectionState.CONNECTED, calleeConnection.getConnectionState());
+
+		caller.close();
+		callee.close();
+	}
+
+	@Test
+	void futureNullParams() {
+		assertThrows(NullPointerException.class, () -> peerConnection.createOfferAsync(null));
+		assertThrows(NullPointerException.class, () -> peerConnection.createAnswerAsync(null));
+		assertThrows(NullPointerException.class, () -> peerConnection.setLocalDescriptionAsync(null));
+		assertThrows(NullPointerException.class, () -> peerConnection.setRemoteDescriptionAsync(null));
+		assertThrows(NullPointerException.class, () -> peerConnection.getStatsAsync(null));
+	}
+
+	@Test
+	void futureNegotiation() throws Exception {
+		TestPeerConnection caller = new TestPeerConnection(factory);
+		TestPeerConnection callee = new TestPeerConnection(factory);
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		RTCPeerConnection callerConnection = caller.getPeerConnection();
+		RTCPeerConnection calleeConnection = callee.getPeerConnection();
+
+		ExecutorService pool = Executors.newSingleThreadExecutor();
+		AtomicInteger executed = new AtomicInteger();
+		Executor executor = command -> {
+			executed.incrementAndGet();
+			pool.execute(command);
+		};
+
+		RTCSessionDescription answer = callerConnection.createOfferAsync(new RTCOfferOptions(), executor)
+				.thenCompose(offer -> callerConnection.setLocalDescriptionAsync(offer, executor)
+						.thenCompose(v -> calleeConnection.setRemoteDescriptionAsync(offer, executor)))
+				.thenCompose(v -> calleeConnection.createAnswerAsync(new RTCAnswerOptions(), executor))
+				.thenCompose(desc -> calleeConnection.setLocalDescriptionAsync(desc, executor)
+						.thenCompose(v -> callerConnection.setRemoteDescriptionAsync(desc, executor))
+						.thenApply(v -> desc))
+				.get(10, TimeUnit.SECONDS);
+
+		assertEquals(RTCSdpType.ANSWER, answer.sdpType);
+		assertEquals(6, executed.get());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		RTCStatsReport report = callerConnection.getStatsAsync().get(10, TimeUnit.SECONDS);
+
+		assertFalse(report.getStats().isEmpty());
+
+		// Errors complete the future exceptionally.
+		CompletableFuture<Void> failed = callerConnection.setRemoteDescriptionAsync(answer, executor);
+
+		assertThrows(ExecutionException.class, () -> failed.get(10, TimeUnit.SECONDS));
+
+		caller.close();
+		callee.close();
+		pool.shutdown();
+	}
+
+	@Test
+	void addIceCandidatesNullParams() {
+		assertThrows(NullPointerException.class, () -> peerConnection.addIceCandidates(null));
+		assertThrows(NullPointerException.class, () -> peerConnection.addIceCandidates(null, new int[0], new String[0]));
+		assertThrows(IllegalArgumentException.class, () -> peerConnection.addIceCandidates(new String[1], new int[0], new String[1]));
+	}
+
+	@Test
+	void addIceCandidates() throws Exception {
+		List<RTCIceCandidate> callerCandidates = new CopyOnWriteArrayList<>();
+		List<RTCIceCandidate> calleeCandidates = new CopyOnWriteArrayList<>();
+
+		RTCPeerConnection caller = factory.createPeerConnection(new RTCConfiguration(), callerCandidates::add);
+		RTCPeerConnection callee = factory.createPeerConnection(new RTCConfiguration(), calleeCandidates::add);
+
+		caller.createDataChannel("dc", new RTCDataChannelInit());
+
+		RTCSessionDescription offer = caller.createOfferAsync(new RTCOfferOptions()).get(10, TimeUnit.SECONDS);
+		caller.setLocalDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+		callee.setRemoteDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+
+		RTCSessionDescription answer = callee.createAnswerAsync(new RTCAnswerOptions()).get(10, TimeUnit.SECONDS);
+		callee.setLocalDescriptionAsync(answer).get(10, TimeUnit.SECONDS);
+		caller.setRemoteDescriptionAsync(answer).get(10, TimeUnit.SECONDS);
+
+		awaitCondition(() -> caller.getIceGatheringState() == RTCIceGatheringState.COMPLETE
+				&& callee.getIceGatheringState() == RTCIceGatheringState.COMPLETE);
+
+		assertFalse(callerCandidates.isEmpty());
+
+		// Whole burst as objects, one bad entry.
+		RTCIceCandidate[] candidates = callerCandidates.toArray(new RTCIceCandidate[callerCandidates.size() + 1]);
+		candidates[candidates.length - 1] = new RTCIceCandidate("0", 0, "candidate:invalid");
+
+		String[] errors = callee.addIceCandidates(candidates).get(10, TimeUnit.SECONDS);
+
+		assertEquals(candidates.length, errors.length);
+
+		for (int i = 0; i < callerCandidates.size(); i++) {
+			assertNull(errors[i]);
+		}
+
+		assertNotNull(errors[errors.length - 1]);
+
+		// Whole burst as raw strings.
+		int count = calleeCandidates.size();
+		String[] sdpMids = new String[count];
+		int[] sdpMLineIndices = new int[count];
+		String[] sdps = new String[count];
+
+		for (int i = 0; i < count; i++) {
+			RTCIceCandidate candidate = calleeCandidates.get(i);
+
+			sdpMids[i] = candidate.sdpMid;
+			sdpMLineIndices[i] = candidate.sdpMLineIndex;
+			sdps[i] = candidate.sdp;
+		}
+
+		errors = caller.addIceCandidates(sdpMids, sdpMLineIndices, sdps).get(10, TimeUnit.SECONDS);
+
+		assertArrayEquals(new String[count], errors);
+
+		awaitCondition(() -> caller.getConnectionState() == RTCPeerConnectionState.CONNECTED
+				&& callee.getConnectionState() == RTCPeerConnectionState.CONNECTED);
+
+		caller.close();
+		callee.close();
+	}
+
+	@Test
+	void iceCandidateBatching() throws Exception {
+		RTCConfiguration config = new RTCConfiguration();
+		config.iceCandidateBatchWindow = RTCConfiguration.ICE_CANDIDATE_BATCH_UNTIL_COMPLETE;
+
+		AtomicInteger single = new AtomicInteger();
+		List<RTCIceCandidate[]> batches = new CopyOnWriteArrayList<>();
+		AtomicInteger batchesBeforeComplete = new AtomicInteger(-1);
+
+		RTCPeerConnection pc = factory.createPeerConnection(config, new PeerConnectionObserver() {
+
+			@Override
+			public void onIceCandidate(RTCIceCandidate candidate) {
+				single.incrementAndGet();
+			}
+
+			@Override
+			public void onIceCandidates(RTCIceCandidate[] candidates) {
+				batches.add(candidates);
+			}
+
+			@Override
+			public void onIceGatheringChange(RTCIceGatheringState state) {
+				if (state == RTCIceGatheringState.COMPLETE) {
+					batchesBeforeComplete.set(batches.size());
+				}
+			}
+		});
+
+		pc.createDataChannel("dc", new RTCDataChannelInit());
+
+		RTCSessionDescription offer = pc.createOfferAsync(new RTCOfferOptions()).get(10, TimeUnit.SECONDS);
+		pc.setLocalDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+
+		awaitCondition(() -> batchesBeforeComplete.get() >= 0);
+
+		assertEquals(0, single.get());
+		assertEquals(1, batches.size());
+		assertEquals(1, batchesBeforeComplete.get());
+		assertTrue(batches.get(0).length > 0);
+
+		pc.close();
+	}
+
+	@Test
+	void iceCandidateBatchingDefault() throws Exception {
+		RTCConfiguration config = new RTCConfiguration();
+		config.iceCandidateBatchWindow = 50;
+
+		List<RTCIceCandidate> candidates = new CopyOnWriteArrayList<>();
+
+		// Observers only implementing onIceCandidate still get all candidates.
+		RTCPeerConnection pc = factory.createPeerConnection(config, candidates::add);
+		pc.createDataChannel("dc", new RTCDataChannelInit());
+
+		RTCSessionDescription offer = pc.createOfferAsync(new RTCOfferOptions()).get(10, TimeUnit.SECONDS);
+		pc.setLocalDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+
+		awaitCondition(() -> pc.getIceGatheringState() == RTCIceGatheringState.COMPLETE && !candidates.isEmpty());
+
+		pc.close();
+	}
+
+	@Test
+	void iceLite() throws Exception {
+		RTCConfiguration serverConfig = new RTCConfiguration();
+		serverConfig.iceLite = true;
+
+		TestPeerConnection client = new TestPeerConnection(factory);
+		TestPeerConnection server = new TestPeerConnection(factory, serverConfig);
+
+		client.setRemotePeerConnection(server);
+		server.setRemotePeerConnection(client);
+
+		RTCSessionDescription offerDesc = client.createOffer();
+
+		assertFalse(offerDesc.sdp.contains("a=ice-lite"));
+
+		server.setRemoteDescription(offerDesc);
+
+		RTCSessionDescription answerDesc = server.createAnswer();
+
+		assertTrue(answerDesc.sdp.contains("a=ice-lite"));
+
+		client.setRemoteDescription(answerDesc);
+
+		client.waitUntilConnected();
+		server.waitUntilConnected();
+
+		assertEquals(RTCPeerConnectionState.CONNECTED, client.getPeerConnection().getConnectionState());
+		assertEquals(RTCPeerConnectionState.CONNECTED, server.getPeerConnection().getConnectionState());
+
+		client.close();
+		server.close();
+	}
+
 	@Test
 	void getStats() throws InterruptedException {
 		CountDownLatch latch = new CountDownLatch(1);
@@ -211,6 +715,55 @@ class RTCPeerConnectionTests extends TestBase {
 		assertFalse(statsReport.getStats().isEmpty());
 	}
 
+	@Test
+	void getStatsSerializedJson() throws InterruptedException {
+		byte[] data = getStatsSerialized(RTCStatsFormat.JSON);
+
+		String json = new String(data, StandardCharsets.UTF_8);
+
+		assertTrue(json.startsWith("["));
+		assertTrue(json.contains("\"type\":\"peer-connection\""));
+	}
+
+	@Test
+	void getStatsSerializedBinary() throws InterruptedException {
+		byte[] data = getStatsSerialized(RTCStatsFormat.BINARY);
+
+		ByteBuffer buffer = ByteBuffer.wrap(data).order(ByteOrder.LITTLE_ENDIAN);
+
+		assertTrue(buffer.getLong() > 0);
+
+		int statsCount = buffer.getInt();
+
+		assertTrue(statsCount > 0);
+
+		for (int i = 0; i < statsCount; i++) {
+			assertFalse(readString(buffer).isEmpty());
+			assertFalse(readString(buffer).isEmpty());
+
+			buffer.getLong();
+
+			int attributeCount = buffer.getInt();
+
+			for (int j = 0; j < attributeCount; j++) {
+				assertFalse(readString(buffer).isEmpty());
+				skipValue(buffer, buffer.get());
+			}
+		}
+
+		assertFalse(buffer.hasRemaining());
+	}
+
+	@Test
+	void getStatsSerializedNullParams() {
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.getStatsSerialized(null, data -> { });
+		});
+		assertThrows(NullPointerException.class, () -> {
+			peerConnection.getStatsSerialized(RTCStatsFormat.JSON, null);
+		});
+	}
+
 	@Test
 	void statesWhenClosed() {
 		RTCConfiguration config = new RTCConfiguration();
@@ -230,4 +783,73 @@ class RTCPeerConnectionTests extends TestBase {
 		assertEquals(RTCIceGatheringState.NEW, peerConnection.getIceGatheringState());
 		assertEquals(RTCIceConnectionState.CLOSED, peerConnection.getIceConnectionState());
 	}
+
+	private byte[] getStatsSerialized(RTCStatsFormat format) throws InterruptedException {
+		CountDownLatch latch = new CountDownLatch(1);
+		AtomicReference<byte[]> dataRef = new AtomicReference<>();
+
+		peerConnection.getStatsSerialized(format, data -> {
+			dataRef.set(data);
+
+			latch.countDown();
+		});
+
+		latch.await();
+
+		assertNotNull(dataRef.get());
+
+		return dataRef.get();
+	}
+
+	private static String readString(ByteBuffer buffer) {
+		byte[] bytes = new byte[buffer.getInt()];
+		buffer.get(bytes);
+
+		return new String(bytes, StandardCharsets.UTF_8);
+	}
+
+	private static void awaitCondition(BooleanSupplier condition) throws InterruptedException {
+		long deadline = System.currentTimeMillis() + 10000;
+
+		while (!condition.getAsBoolean()) {
+			assertTrue(System.currentTimeMillis() < deadline, "Condition not met in time");
+
+			Thread.sleep(20);
+		}
+	}
+
+	private static void skipValue(ByteBuffer buffer, int tag) {
+		if (tag < 7) {
+			switch (tag) {
+				case 0 -> buffer.get();
+				case 1, 2 -> buffer.getInt();
+				case 3, 4, 5 -> buffer.getLong();
+				default -> readString(buffer);
+			}
+			return;
+		}
+
+		assertTrue(tag <= 15, "Unknown attribute tag " + tag);
+
+		int count = buffer.getInt();
+
+		for (int i = 0; i < count; i++) {
+			if (tag >= 14) {
+				readString(buffer);
+				buffer.getLong();
+			}
+			else if (tag == 13) {
+				readString(buffer);
+			}
+			else if (tag == 7) {
+				buffer.get();
+			}
+			else if (tag <= 9) {
+				buffer.getInt();
+			}
+			else {
+				buffer.getLong();
+			}
+		}
+	}
 }
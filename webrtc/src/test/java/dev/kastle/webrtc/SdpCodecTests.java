@@ -0,0 +1,187 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import org.junit.jupiter.api.Test;
+
+class SdpCodecTests extends TestBase {
+
+	@Test
+	void nullParams() {
+		assertThrows(NullPointerException.class, () -> SdpCodec.encodeDescription(null));
+		assertThrows(NullPointerException.class, () -> SdpCodec.decodeDescription(null));
+		assertThrows(NullPointerException.class, () -> SdpCodec.encodeCandidates(null));
+		assertThrows(NullPointerException.class, () -> SdpCodec.decodeCandidates(null));
+		assertThrows(NullPointerException.class, () -> SdpCodec.encodeCandidates(new RTCIceCandidate[1]));
+	}
+
+	@Test
+	void invalidInput() {
+		assertThrows(Error.class, () -> SdpCodec.decodeDescription(new byte[0]));
+		assertThrows(Error.class, () -> SdpCodec.decodeDescription(new byte[] { 1, 0, 0 }));
+		assertThrows(Error.class, () -> SdpCodec.decodeDescription(new byte[] { 9 }));
+		assertThrows(Error.class, () -> SdpCodec.decodeCandidates(new byte[] { 1, 0, 1 }));
+	}
+
+	@Test
+	void candidates() {
+		RTCIceCandidate[] candidates = {
+				new RTCIceCandidate("0", 0, "candidate:1 1 udp 2122260223 192.168.1.10 50000 typ host generation 0 ufrag abcd network-id 1"),
+				new RTCIceCandidate("0", 0, "candidate:2 1 udp 1686052607 203.0.113.7 50001 typ srflx raddr 192.168.1.10 rport 50000 generation 0 ufrag abcd network-id 1"),
+				new RTCIceCandidate("0", 0, "candidate:3 1 tcp 1518280447 fd00::1 9 typ host tcptype active generation 0 ufrag abcd network-id 2"),
+				new RTCIceCandidate("0", 0, "candidate:4 1 udp 2122260223 7f5a2c1e-1f0b-4c3e-9a6d-3d2e1f0a9b8c.local 50002 typ host generation 0 ufrag abcd network-id 3")
+		};
+
+		byte[] encoded = SdpCodec.encodeCandidates(candidates);
+		RTCIceCandidate[] decoded = SdpCodec.decodeCandidates(encoded);
+
+		assertEquals(candidates.length, decoded.length);
+
+		int sdpLength = 0;
+
+		for (int i = 0; i < candidates.length; i++) {
+			assertEquals(candidates[i].sdpMid, decoded[i].sdpMid);
+			assertEquals(candidates[i].sdpMLineIndex, decoded[i].sdpMLineIndex);
+			sdpLength += candidates[i].sdp.getBytes(StandardCharsets.UTF_8).length;
+		}
+
+		// Resolved addresses serialize back to the same candidate lines.
+		for (int i = 0; i < 3; i++) {
+			assertEquals(candidates[i].sdp, decoded[i].sdp);
+		}
+
+		assertArrayEquals(encoded, SdpCodec.encodeCandidates(decoded));
+		assertTrue(encoded.length < sdpLength / 2);
+
+		assertEquals(0, SdpCodec.decodeCandidates(SdpCodec.encodeCandidates(new RTCIceCandidate[0])).length);
+	}
+
+	@Test
+	void descriptions() throws Exception {
+		GatheringPeer caller = new GatheringPeer(factory);
+		GatheringPeer callee = new GatheringPeer(factory);
+
+		RTCDataChannel channel = caller.peerConnection.createDataChannel("codec", new RTCDataChannelInit());
+
+		// Offer.
+		TestCreateDescObserver createObserver = new TestCreateDescObserver();
+		caller.peerConnection.createOffer(new RTCOfferOptions(), createObserver);
+		caller.setLocalDescription(createObserver.get());
+
+		RTCSessionDescription offer = caller.gatheredDescription();
+		byte[] encodedOffer = SdpCodec.encodeDescription(offer);
+		RTCSessionDescription decodedOffer = SdpCodec.decodeDescription(encodedOffer);
+
+		assertEquals(RTCSdpType.OFFER, decodedOffer.sdpType);
+		assertTrue(encodedOffer.length < offer.sdp.length() / 2);
+		assertTrue(decodedOffer.sdp.contains("a=candidate:"));
+
+		callee.setRemoteDescription(decodedOffer);
+
+		// Answer.
+		createObserver = new TestCreateDescObserver();
+		callee.peerConnection.createAnswer(new RTCAnswerOptions(), createObserver);
+		callee.setLocalDescription(createObserver.get());
+
+		RTCSessionDescription answer = callee.gatheredDescription();
+		RTCSessionDescription decodedAnswer = SdpCodec.decodeDescription(SdpCodec.encodeDescription(answer));
+
+		assertEquals(RTCSdpType.ANSWER, decodedAnswer.sdpType);
+
+		caller.setRemoteDescription(decodedAnswer);
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		channel.close();
+		channel.dispose();
+		caller.peerConnection.close();
+		callee.peerConnection.close();
+	}
+
+
+
+	private static class GatheringPeer implements PeerConnectionObserver {
+
+		final RTCPeerConnection peerConnection;
+
+		final CompletableFuture<Void> gathered = new CompletableFuture<>();
+
+		final CountDownLatch connected = new CountDownLatch(1);
+
+
+		GatheringPeer(PeerConnectionFactory factory) {
+			RTCConfiguration config = new RTCConfiguration();
+			config.iceCandidateBatchWindow = RTCConfiguration.ICE_CANDIDATE_BATCH_UNTIL_COMPLETE;
+
+			peerConnection = factory.createPeerConnection(config, this);
+		}
+
+		@Override
+		public void onIceCandidate(RTCIceCandidate candidate) {
+
+		}
+
+		@Override
+		public void onIceCandidates(RTCIceCandidate[] candidates) {
+			// All candidates are carried by the encoded description.
+		}
+
+		@Override
+		public void onIceGatheringChange(RTCIceGatheringState state) {
+			if (state == RTCIceGatheringState.COMPLETE) {
+				gathered.complete(null);
+			}
+		}
+
+		@Override
+		public void onConnectionChange(RTCPeerConnectionState state) {
+			if (state == RTCPeerConnectionState.CONNECTED) {
+				connected.countDown();
+			}
+		}
+
+		void setLocalDescription(RTCSessionDescription description) throws Exception {
+			TestSetDescObserver setObserver = new TestSetDescObserver();
+			peerConnection.setLocalDescription(description, setObserver);
+			setObserver.get();
+		}
+
+		void setRemoteDescription(RTCSessionDescription description) throws Exception {
+			TestSetDescObserver setObserver = new TestSetDescObserver();
+			peerConnection.setRemoteDescription(description, setObserver);
+			setObserver.get();
+		}
+
+		RTCSessionDescription gatheredDescription() throws Exception {
+			gathered.get(10, TimeUnit.SECONDS);
+
+			return peerConnection.getLocalDescription();
+		}
+
+		void waitUntilConnected() throws InterruptedException {
+			assertTrue(connected.await(10, TimeUnit.SECONDS));
+		}
+	}
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.concurrent.TimeUnit;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.condition.EnabledIfSystemProperty;
+
+/**
+ * Compares the SDP template fast path with the generic serializer and
+ * parser. Runs only with {@code -Dwebrtc.benchmark=true}, since timings are
+ * meaningless on shared build machines.
+ *
+ * @author Alex Andres
+ */
+@EnabledIfSystemProperty(named = "webrtc.benchmark", matches = "true")
+class SdpTemplateBenchmark extends TestBase {
+
+	private static final int WARMUP_ITERATIONS = 500;
+
+	private static final int ITERATIONS = 5000;
+
+
+	@Test
+	void serializeAndParse() throws Exception {
+		RTCPeerConnection offerer = factory.createPeerConnection(new RTCConfiguration(), candidate -> {});
+		offerer.createDataChannel("dc", new RTCDataChannelInit());
+
+		RTCSessionDescription offer = offerer.createOfferAsync(new RTCOfferOptions()).get(10, TimeUnit.SECONDS);
+		offerer.setLocalDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+
+		long deadline = System.currentTimeMillis() + 10000;
+
+		while (offerer.getIceGatheringState() != RTCIceGatheringState.COMPLETE) {
+			assertTrue(System.currentTimeMillis() < deadline, "Gathering not completed in time");
+
+			Thread.sleep(20);
+		}
+
+		// A typical offer with candidates.
+		offer = offerer.getLocalDescription();
+
+		Result generic = measure(offer, false);
+		Result template = measure(offer, true);
+
+		System.out.printf("SDP parse:     generic %8.2f us, template %8.2f us%n", generic.parseMicros, template.parseMicros);
+		System.out.printf("SDP serialize: generic %8.2f us, template %8.2f us%n", generic.serializeMicros, template.serializeMicros);
+
+		offerer.close();
+	}
+
+	private Result measure(RTCSessionDescription offer, boolean sdpTemplate) throws Exception {
+		RTCConfiguration config = new RTCConfiguration();
+		config.sdpTemplate = sdpTemplate;
+
+		RTCPeerConnection answerer = factory.createPeerConnection(config, candidate -> {});
+
+		// Setting the same remote offer again includes the cost of applying
+		// it, which is the same for both paths.
+		for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+			answerer.setRemoteDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+		}
+
+		long start = System.nanoTime();
+
+		for (int i = 0; i < ITERATIONS; i++) {
+			answerer.setRemoteDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+		}
+
+		double parseMicros = (System.nanoTime() - start) / 1000.0 / ITERATIONS;
+
+		for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+			answerer.getRemoteDescription();
+		}
+
+		start = System.nanoTime();
+
+		for (int i = 0; i < ITERATIONS; i++) {
+			answerer.getRemoteDescription();
+		}
+
+		double serializeMicros = (System.nanoTime() - start) / 1000.0 / ITERATIONS;
+
+		answerer.close();
+
+		return new Result(parseMicros, serializeMicros);
+	}
+
+	private record Result(double parseMicros, double serializeMicros) {
+
+	}
+
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.condition.EnabledIfSystemProperty;
+
+/**
+ * Compares the receive rate of the batching socket server, which reads
+ * datagrams with recvmmsg, with the default socket server reading one
+ * datagram per call. Small data channel messages are sent over loopback, so
+ * that each one is a datagram of its own. Runs only on Linux and with {@code
+ * -Dwebrtc.benchmark=true}, since timings are meaningless on shared build
+ * machines.
+ *
+ * @author Alex Andres
+ */
+@EnabledIfSystemProperty(named = "webrtc.benchmark", matches = "true")
+class SocketServerBenchmark {
+
+	private static final int WARMUP_MESSAGES = 10000;
+
+	private static final int MESSAGES = 100000;
+
+	private static final int MESSAGE_SIZE = 200;
+
+
+	@Test
+	void receiveRate() throws Exception {
+		assumeTrue(System.getProperty("os.name").toLowerCase().contains("linux"),
+				"The batching socket server is only available on Linux");
+
+		double perDatagram = measure(SocketServerType.DEFAULT);
+		double batching = measure(SocketServerType.BATCHING);
+
+		System.out.printf("Receive rate: default %10.0f datagrams/s, batching %10.0f datagrams/s%n",
+				perDatagram, batching);
+	}
+
+	private double measure(SocketServerType socketServer) throws Exception {
+		PeerConnectionFactoryConfig config = new PeerConnectionFactoryConfig();
+		config.socketServer = socketServer;
+
+		PeerConnectionFactory factory = new PeerConnectionFactory(config);
+		TestDataChannelPair pair = new TestDataChannelPair(factory);
+
+		pair.transfer(WARMUP_MESSAGES, MESSAGE_SIZE);
+
+		long nanos = pair.transfer(MESSAGES, MESSAGE_SIZE);
+
+		pair.close();
+		factory.dispose();
+
+		return MESSAGES / (nanos / 1e9);
+	}
+
+}
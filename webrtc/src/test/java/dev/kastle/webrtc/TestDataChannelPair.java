@@ -0,0 +1,168 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Two connected peer connections of one factory with a data channel from the
+ * caller to the callee, which counts the messages it receives. Used by the
+ * benchmarks to measure connection setup and message rates.
+ *
+ * @author Alex Andres
+ */
+class TestDataChannelPair {
+
+	private static final String LABEL = "benchmark";
+
+	// Keeps the send queue of the channel well below its limit.
+	private static final long MAX_BUFFERED_AMOUNT = 1024 * 1024;
+
+	private final TestPeerConnection caller;
+
+	private final ReceivingPeerConnection callee;
+
+	private final RTCDataChannel channel;
+
+
+	TestDataChannelPair(PeerConnectionFactory factory) throws Exception {
+		caller = new TestPeerConnection(factory);
+		callee = new ReceivingPeerConnection(factory);
+
+		channel = caller.getPeerConnection().createDataChannel(LABEL, new RTCDataChannelInit());
+
+		caller.setRemotePeerConnection(callee);
+		callee.setRemotePeerConnection(caller);
+
+		callee.setRemoteDescription(caller.createOffer());
+		caller.setRemoteDescription(callee.createAnswer());
+
+		caller.waitUntilConnected();
+		callee.waitUntilConnected();
+
+		long deadline = System.currentTimeMillis() + 10000;
+
+		while (channel.getState() != RTCDataChannelState.OPEN || !callee.hasChannel()) {
+			if (System.currentTimeMillis() > deadline) {
+				throw new IllegalStateException("Data channel not opened in time");
+			}
+
+			Thread.sleep(5);
+		}
+	}
+
+	/**
+	 * Sends the messages and waits until the callee received all of them.
+	 *
+	 * @return The time in nanoseconds from the first message sent to the
+	 *         last one received.
+	 */
+	long transfer(int count, int size) throws Exception {
+		ByteBuffer data = ByteBuffer.allocateDirect(size);
+		long expected = callee.received.get() + count;
+		long start = System.nanoTime();
+
+		for (int i = 0; i < count; i++) {
+			while (channel.getBufferedAmount() > MAX_BUFFERED_AMOUNT) {
+				Thread.onSpinWait();
+			}
+
+			channel.send(new RTCDataChannelBuffer(data.duplicate(), true));
+		}
+
+		long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(30);
+
+		while (callee.received.get() < expected) {
+			if (System.nanoTime() > deadline) {
+				throw new IllegalStateException("Messages not received in time");
+			}
+
+			Thread.onSpinWait();
+		}
+
+		return callee.lastReceived - start;
+	}
+
+	void close() {
+		channel.close();
+		channel.dispose();
+
+		callee.close();
+		caller.close();
+	}
+
+
+
+	private static class ReceivingPeerConnection extends TestPeerConnection {
+
+		private final CountDownLatch channelLatch = new CountDownLatch(1);
+
+		private final AtomicLong received = new AtomicLong();
+
+		private volatile long lastReceived;
+
+		private RTCDataChannel remoteChannel;
+
+
+		ReceivingPeerConnection(PeerConnectionFactory factory) {
+			super(factory);
+		}
+
+		@Override
+		public void onDataChannel(RTCDataChannel dataChannel) {
+			if (!LABEL.equals(dataChannel.getLabel())) {
+				return;
+			}
+
+			remoteChannel = dataChannel;
+			remoteChannel.registerObserver(new RTCDataChannelObserver() {
+
+				@Override
+				public void onBufferedAmountChange(long previousAmount) { }
+
+				@Override
+				public void onStateChange() { }
+
+				@Override
+				public void onMessage(RTCDataChannelBuffer buffer) {
+					lastReceived = System.nanoTime();
+					received.incrementAndGet();
+				}
+			});
+
+			channelLatch.countDown();
+		}
+
+		boolean hasChannel() {
+			return channelLatch.getCount() == 0;
+		}
+
+		@Override
+		void close() {
+			if (remoteChannel != null) {
+				remoteChannel.unregisterObserver();
+				remoteChannel.close();
+				remoteChannel.dispose();
+			}
+
+			super.close();
+		}
+	}
+}
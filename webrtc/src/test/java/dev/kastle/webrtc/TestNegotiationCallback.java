@@ -0,0 +1,39 @@
+/*
+ * Copyright 2025 Alex Andres
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.kastle.webrtc;
+
+import java.util.concurrent.CompletableFuture;
+
+/**
+ * {@link NegotiationCallback} implementation completing with the SDP of the
+ * applied local description.
+ *
+ * @author Alex Andres
+ */
+class TestNegotiationCallback extends CompletableFuture<String> implements NegotiationCallback {
+
+	@Override
+	public void onSuccess(String sdp) {
+		complete(sdp);
+	}
+
+	@Override
+	public void onFailure(String error) {
+		completeExceptionally(new Exception(error));
+	}
+
+}
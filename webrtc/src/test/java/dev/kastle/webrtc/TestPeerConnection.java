@@ -36,8 +36,10 @@ class TestPeerConnection implements PeerConnectionObserver {
 
 
 	TestPeerConnection(PeerConnectionFactory factory) {
-		RTCConfiguration config = new RTCConfiguration();
+		this(factory, new RTCConfiguration());
+	}
 
+	TestPeerConnection(PeerConnectionFactory factory, RTCConfiguration config) {
 		localPeerConnection = factory.createPeerConnection(config, this);
 		localPeerConnection.createDataChannel("dummy", new RTCDataChannelInit());
 
@@ -20,8 +20,14 @@ import static org.junit.jupiter.api.Assertions.*;
 
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
 
 import dev.kastle.webrtc.PeerConnectionFactory;
+import dev.kastle.webrtc.RTCConfiguration;
+import dev.kastle.webrtc.RTCDataChannelInit;
+import dev.kastle.webrtc.RTCOfferOptions;
+import dev.kastle.webrtc.RTCPeerConnection;
+import dev.kastle.webrtc.RTCSessionDescription;
 import dev.kastle.webrtc.logging.Logging.Severity;
 
 import org.junit.jupiter.api.Test;
@@ -49,4 +55,69 @@ class LoggingTests {
 		factory.dispose();
 	}
 
+	@Test
+	void batchedAndFiltered() throws Exception {
+		CountDownLatch latch = new CountDownLatch(1);
+		CountDownLatch included = new CountDownLatch(1);
+		AtomicBoolean excluded = new AtomicBoolean();
+
+		LogSink batchedSink = new LogSink() {
+
+			@Override
+			public void onLogMessage(Severity severity, String message) { }
+
+			@Override
+			public void onLogMessages(LogRecord[] records) {
+				for (LogRecord record : records) {
+					if (record.getSeverity() == Severity.INFO
+							&& record.getTimestamp() > 0
+							&& record.getMessage().contains("Batched log message")) {
+						latch.countDown();
+					}
+				}
+			}
+		};
+
+		Logging.addLogSink(Logging.Severity.INFO, batchedSink);
+
+		// Messages logged from Java are tagged with the JNI source file.
+		LogSinkConfig config = new LogSinkConfig();
+		config.excludedTags = new String[] { "JNI_Logging.cpp" };
+
+		LogSink filteredSink = (severity, message) -> {
+			if (message.contains("Batched log message")) {
+				excluded.set(true);
+			}
+			else if (!message.contains("(JNI_Logging.cpp:")) {
+				included.countDown();
+			}
+		};
+
+		Logging.addLogSink(Logging.Severity.INFO, filteredSink, config);
+
+		Logging.info("Batched log message");
+
+		assertTrue(latch.await(5, TimeUnit.SECONDS), "Did not receive log message");
+
+		// Messages of WebRTC itself, e.g. signaling state changes, pass the
+		// filter of the same sink.
+		PeerConnectionFactory factory = new PeerConnectionFactory();
+		RTCPeerConnection peerConnection = factory.createPeerConnection(new RTCConfiguration(), candidate -> { });
+		peerConnection.createDataChannel("log", new RTCDataChannelInit());
+
+		RTCSessionDescription offer = peerConnection.createOfferAsync(new RTCOfferOptions()).get(10, TimeUnit.SECONDS);
+		peerConnection.setLocalDescriptionAsync(offer).get(10, TimeUnit.SECONDS);
+
+		assertTrue(included.await(5, TimeUnit.SECONDS), "Did not receive a message with another tag");
+
+		peerConnection.close();
+		factory.dispose();
+
+		// Removing the sinks delivers everything buffered so far.
+		Logging.removeLogSink(filteredSink);
+		Logging.removeLogSink(batchedSink);
+
+		assertFalse(excluded.get(), "Excluded tag was delivered");
+	}
+
 }